@@ -0,0 +1,89 @@
+#include <go/symbol/reader.h>
+#include <limits>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <algorithm>
+
+constexpr auto LOOKUP_COUNT = 4000000;
+constexpr auto ITERATION_COUNT = 100;
+constexpr auto ROUND_COUNT = 9;
+constexpr auto RANDOM_SEED = 1;
+
+namespace {
+    template<typename F>
+    double measure(size_t operations, F &&f) {
+        double best = std::numeric_limits<double>::max();
+
+        for (int i = 0; i < ROUND_COUNT; i++) {
+            auto start = std::chrono::steady_clock::now();
+            f();
+            auto elapsed = std::chrono::steady_clock::now() - start;
+
+            best = std::min(best, std::chrono::duration<double, std::nano>(elapsed).count() / double(operations));
+        }
+
+        return best;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <go binary> [anonymous]\n", argv[0]);
+        return 1;
+    }
+
+    std::optional<go::symbol::Reader> reader = go::symbol::openFile(argv[1]);
+
+    if (!reader) {
+        fprintf(stderr, "open %s failed\n", argv[1]);
+        return 1;
+    }
+
+    go::symbol::AccessMethod method = argc > 2 ? go::symbol::AnonymousMemory : go::symbol::FileMapping;
+    std::optional<go::symbol::SymbolTable> table = reader->symbols(method);
+
+    if (!table || table->size() < 2) {
+        fprintf(stderr, "load symbol table failed\n");
+        return 1;
+    }
+
+    uint64_t low = (*table->begin()).entry();
+    uint64_t high = (*(table->begin() + std::ptrdiff_t(table->size() - 1))).entry();
+
+    std::mt19937_64 random(RANDOM_SEED);
+    std::vector<uint64_t> pcs(LOOKUP_COUNT);
+
+    for (auto &pc: pcs)
+        pc = low + random() % (high - low);
+
+    uint64_t sink = 0;
+
+    double find = measure(pcs.size(), [&]() {
+        for (uint64_t pc: pcs) {
+            go::symbol::Symbol symbol = (*table->find(pc)).symbol();
+            sink += symbol.entry() + (uintptr_t) symbol.name();
+        }
+    });
+
+    double iterate = measure(ITERATION_COUNT * table->size(), [&]() {
+        for (int i = 0; i < ITERATION_COUNT; i++) {
+            for (const auto &entry: *table)
+                sink += entry.entry() + (uintptr_t) entry.symbol().name();
+        }
+    });
+
+    double line = measure(pcs.size() / 8, [&]() {
+        for (size_t i = 0; i < pcs.size() / 8; i++) {
+            go::symbol::Symbol symbol = (*table->find(pcs[i])).symbol();
+            sink += symbol.sourceLine(pcs[i]);
+        }
+    });
+
+    printf("functions:           %zu\n", table->size());
+    printf("find+entry+name:     %.1f ns/op\n", find);
+    printf("iterate+name:        %.2f ns/func\n", iterate);
+    printf("find+sourceLine:     %.1f ns/op\n", line);
+
+    return sink == 0;
+}
@@ -0,0 +1,49 @@
+#ifndef GO_SYMBOL_ARENA_H
+#define GO_SYMBOL_ARENA_H
+
+#include <span>
+#include <memory>
+#include <vector>
+#include <string_view>
+#include <type_traits>
+
+namespace go {
+    class Arena {
+    public:
+        explicit Arena(size_t chunkSize = 64 * 1024);
+
+    public:
+        void *allocate(size_t size, size_t alignment);
+
+    public:
+        template<typename T, typename... Args>
+        T *make(Args &&... args) {
+            static_assert(std::is_trivially_destructible_v<T>);
+            return new(allocate(sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+        }
+
+        template<typename T>
+        std::span<T> array(size_t count) {
+            static_assert(std::is_trivially_destructible_v<T>);
+
+            if (!count)
+                return {};
+
+            T *ptr = static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+            std::uninitialized_value_construct_n(ptr, count);
+
+            return {ptr, count};
+        }
+
+    public:
+        [[nodiscard]] size_t capacity() const;
+
+    private:
+        size_t mChunkSize;
+        size_t mOffset;
+        size_t mCapacity;
+        std::vector<std::unique_ptr<std::byte[]>> mChunks;
+    };
+}
+
+#endif //GO_SYMBOL_ARENA_H
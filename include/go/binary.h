@@ -9,6 +9,9 @@
 namespace go::binary {
     std::optional<std::pair<int64_t, int>> varInt(const std::byte *buffer);
     std::optional<std::pair<uint64_t, int>> uVarInt(const std::byte *buffer);
+
+    const std::byte *varInt(const std::byte *buffer, int64_t &value) noexcept;
+    const std::byte *uVarInt(const std::byte *buffer, uint64_t &value) noexcept;
 }
 
 #endif //GO_SYMBOL_BINARY_H
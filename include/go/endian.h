@@ -12,6 +12,11 @@ namespace go::endian {
 
         }
 
+    public:
+        [[nodiscard]] elf::endian::Type endian() const {
+            return mEndian;
+        }
+
     public:
         template<typename T>
         T operator()(T bits) const {
@@ -0,0 +1,73 @@
+#ifndef GO_SYMBOL_MEMORY_H
+#define GO_SYMBOL_MEMORY_H
+
+#include <span>
+#include <memory>
+#include <optional>
+#include <functional>
+
+namespace go::memory {
+    enum HugePage {
+        NoHugePage,
+        TransparentHugePage,
+        ExplicitHugePage
+    };
+
+    enum Backing {
+        AnonymousBacking,
+        FileBacking
+    };
+
+    struct Usage {
+        size_t heap;
+        size_t mapped;
+        size_t resident;
+    };
+
+    class IAllocator {
+    public:
+        virtual ~IAllocator() = default;
+
+    public:
+        virtual std::byte *allocate(size_t size) = 0;
+        virtual void deallocate(std::byte *ptr, size_t size) = 0;
+    };
+
+    class Buffer {
+    public:
+        Buffer(
+                std::byte *data,
+                size_t size,
+                HugePage hugePage,
+                std::function<void(std::byte *, size_t)> release,
+                Backing backing = AnonymousBacking
+        );
+        Buffer(Buffer &&rhs) noexcept;
+        ~Buffer();
+
+    public:
+        Buffer &operator=(Buffer &&rhs) noexcept;
+
+    public:
+        [[nodiscard]] std::byte *data() const;
+        [[nodiscard]] size_t size() const;
+
+    public:
+        [[nodiscard]] bool hugePage() const;
+        [[nodiscard]] Backing backing() const;
+
+    private:
+        std::byte *mData;
+        size_t mSize;
+        HugePage mHugePage;
+        Backing mBacking;
+        std::function<void(std::byte *, size_t)> mRelease;
+    };
+
+    std::optional<Buffer> allocate(size_t size, HugePage hugePage = NoHugePage);
+    std::optional<Buffer> allocate(size_t size, const std::shared_ptr<IAllocator> &allocator);
+    std::optional<Buffer> borrow(std::span<std::byte> region, size_t size);
+    std::optional<size_t> resident(std::span<const std::byte> region);
+}
+
+#endif //GO_SYMBOL_MEMORY_H
@@ -0,0 +1,54 @@
+#ifndef GO_SYMBOL_BATCH_H
+#define GO_SYMBOL_BATCH_H
+
+#include "stack.h"
+#include <chrono>
+
+namespace go::symbol {
+    enum FrameState {
+        PendingFrame,
+        ResolvedFrame,
+        UnresolvedFrame
+    };
+
+    struct WorkBudget {
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+        std::optional<size_t> bytes;
+    };
+
+    class BatchSymbolizer {
+    public:
+        BatchSymbolizer(const SymbolTable *table, std::span<const uint64_t> pcs);
+
+    public:
+        bool resume(const WorkBudget &budget = {});
+
+    public:
+        [[nodiscard]] bool done() const;
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] size_t remaining() const;
+
+    public:
+        [[nodiscard]] bool resolved(size_t index) const;
+        [[nodiscard]] FrameState state(size_t index) const;
+        [[nodiscard]] const Frame &frame(size_t index) const;
+
+    private:
+        struct Cursor {
+            Symbol symbol;
+            uint64_t end;
+            PCValue lines;
+            PCValue files;
+        };
+
+    private:
+        size_t mNext;
+        const SymbolTable *mTable;
+        std::vector<Frame> mFrames;
+        std::vector<uint32_t> mOrder;
+        std::vector<FrameState> mStates;
+        std::optional<Cursor> mCursor;
+    };
+}
+
+#endif //GO_SYMBOL_BATCH_H
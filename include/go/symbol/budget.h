@@ -0,0 +1,94 @@
+#ifndef GO_SYMBOL_BUDGET_H
+#define GO_SYMBOL_BUDGET_H
+
+#include "reader.h"
+#include "name_index.h"
+#include "file_index.h"
+#include <mutex>
+
+namespace go::symbol {
+    enum TableMode {
+        AnonymousTable,
+        MappedTable,
+        SeekTable
+    };
+
+    class IBudgetResource {
+    public:
+        virtual ~IBudgetResource() = default;
+
+    public:
+        virtual memory::Usage memoryUsage() = 0;
+        virtual bool shrink() = 0;
+    };
+
+    class ManagedSymbolTable : public IBudgetResource {
+    public:
+        ManagedSymbolTable(
+                Reader reader,
+                SymbolOptions options = {},
+                uint64_t base = 0,
+                StringPool *pool = &StringPool::global()
+        );
+
+    public:
+        bool open(TableMode mode);
+        [[nodiscard]] TableMode mode();
+
+    public:
+        std::shared_ptr<const SymbolTable> symbols();
+        std::shared_ptr<seek::SymbolTable> seekSymbols();
+
+    public:
+        std::shared_ptr<const NameIndex> nameIndex();
+        std::shared_ptr<const FileIndex> fileIndex();
+
+    public:
+        memory::Usage memoryUsage() override;
+        bool shrink() override;
+
+    private:
+        bool load(TableMode mode);
+
+    private:
+        uint64_t mBase;
+        TableMode mMode;
+        Reader mReader;
+        SymbolOptions mOptions;
+        StringPool *mPool;
+        std::mutex mMutex;
+
+    private:
+        std::shared_ptr<SymbolTable> mTable;
+        std::shared_ptr<seek::SymbolTable> mSeekTable;
+        std::shared_ptr<const NameIndex> mNameIndex;
+        std::shared_ptr<const FileIndex> mFileIndex;
+    };
+
+    class BudgetManager {
+    public:
+        explicit BudgetManager(size_t limit = 0);
+
+    public:
+        void limit(size_t limit);
+        [[nodiscard]] size_t limit();
+
+    public:
+        void add(const std::shared_ptr<IBudgetResource> &resource);
+        memory::Usage usage();
+        size_t enforce();
+
+    public:
+        static BudgetManager &global();
+
+    private:
+        std::vector<std::shared_ptr<IBudgetResource>> resources();
+
+    private:
+        size_t mLimit;
+        std::mutex mMutex;
+        std::vector<std::weak_ptr<IBudgetResource>> mResources;
+    };
+}
+
+#endif //GO_SYMBOL_BUDGET_H
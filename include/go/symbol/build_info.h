@@ -22,6 +22,7 @@ namespace go::symbol {
     class BuildInfo {
     public:
         BuildInfo(elf::Reader reader, std::shared_ptr<elf::ISection> section);
+        BuildInfo(elf::Reader reader, const std::byte *data);
 
     public:
         std::optional<Version> version();
@@ -37,6 +38,7 @@ namespace go::symbol {
 
     private:
         elf::Reader mReader;
+        const std::byte *mData;
         std::shared_ptr<elf::ISection> mSection;
     };
 }
@@ -0,0 +1,52 @@
+#ifndef GO_SYMBOL_EXPORTER_H
+#define GO_SYMBOL_EXPORTER_H
+
+#include "symbol.h"
+#include <ostream>
+#include <functional>
+
+namespace go::symbol {
+    struct BreakpadModule {
+        std::string os;
+        std::string arch;
+        std::string id;
+        std::string name;
+        uint64_t base;
+    };
+
+    constexpr auto BPF_RANGE_MAGIC = 0x4f475342;
+    constexpr auto BPF_RANGE_VERSION = 1;
+
+    struct BPFRangeHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t offset;
+        uint32_t count;
+        uint64_t base;
+        uint64_t end;
+    };
+
+    struct BPFRange {
+        uint32_t delta;
+        uint32_t id;
+    };
+
+    class Exporter {
+    public:
+        explicit Exporter(const SymbolTable *table, size_t threads = 0);
+
+    public:
+        bool perfMap(std::ostream &stream) const;
+        bool breakpad(std::ostream &stream, const BreakpadModule &module) const;
+        bool bpf(std::ostream &ranges, std::ostream &names) const;
+
+    private:
+        bool write(std::ostream &stream, const std::function<void(std::string &, size_t, size_t)> &generate) const;
+
+    private:
+        const SymbolTable *mTable;
+        size_t mThreads;
+    };
+}
+
+#endif //GO_SYMBOL_EXPORTER_H
@@ -0,0 +1,42 @@
+#ifndef GO_SYMBOL_FILE_INDEX_H
+#define GO_SYMBOL_FILE_INDEX_H
+
+#include "symbol.h"
+#include "string_pool.h"
+#include <unordered_map>
+
+namespace go::symbol {
+    class FileIndex {
+    public:
+        explicit FileIndex(const SymbolTable *table, StringPool *pool = nullptr);
+        FileIndex(const FileIndex &) = delete;
+        FileIndex(FileIndex &&) = default;
+        ~FileIndex();
+
+    public:
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] memory::Usage memoryUsage() const;
+        [[nodiscard]] std::string_view name(uint32_t id) const;
+        [[nodiscard]] std::optional<uint32_t> poolID(uint32_t id) const;
+
+    public:
+        [[nodiscard]] std::optional<uint32_t> find(std::string_view name) const;
+        [[nodiscard]] std::vector<uint32_t> match(std::string_view name) const;
+
+    public:
+        [[nodiscard]] std::optional<uint32_t> id(uint32_t key) const;
+        [[nodiscard]] std::optional<uint32_t> sourceFile(const Symbol &symbol, uint64_t pc) const;
+        [[nodiscard]] std::span<const uint32_t> functions(uint32_t id) const;
+
+    private:
+        StringPool *mPool;
+        std::vector<uint32_t> mPoolIDs;
+        std::vector<uint32_t> mOffsets;
+        std::vector<uint32_t> mFunctions;
+        std::vector<std::string_view> mNames;
+        std::unordered_map<uint32_t, uint32_t> mKeys;
+        std::unordered_map<std::string_view, uint32_t> mIDs;
+    };
+}
+
+#endif //GO_SYMBOL_FILE_INDEX_H
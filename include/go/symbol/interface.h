@@ -2,8 +2,10 @@
 #define GO_SYMBOL_INTERFACE_H
 
 #include <go/endian.h>
+#include <go/memory.h>
 #include <go/version.h>
 #include <elf/reader.h>
+#include <span>
 
 namespace go::symbol {
     class Interface;
@@ -21,8 +23,19 @@ namespace go::symbol {
                 endian::Converter converter
         );
 
+        InterfaceTable(
+                elf::Reader reader,
+                std::span<const std::byte> links,
+                Version version,
+                uint64_t types,
+                uint64_t base,
+                size_t ptrSize,
+                endian::Converter converter
+        );
+
     public:
         [[nodiscard]] size_t size() const;
+        [[nodiscard]] memory::Usage memoryUsage() const;
 
     public:
         [[nodiscard]] Interface operator[](size_t index) const;
@@ -39,6 +52,7 @@ namespace go::symbol {
         endian::Converter mConverter;
         elf::Reader mReader;
         std::shared_ptr<elf::ISection> mSection;
+        std::span<const std::byte> mLinks;
 
         friend class Interface;
         friend class InterfaceIterator;
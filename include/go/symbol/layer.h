@@ -0,0 +1,53 @@
+#ifndef GO_SYMBOL_LAYER_H
+#define GO_SYMBOL_LAYER_H
+
+#include "reader.h"
+#include <string>
+#include <vector>
+#include <optional>
+#include <filesystem>
+#include <unordered_map>
+
+namespace go::symbol {
+    class GzipStream;
+
+    enum LayerEntryType {
+        RegularEntry,
+        HardLinkEntry,
+        SymbolicLinkEntry
+    };
+
+    struct LayerEntry {
+        std::string name;
+        std::string link;
+        LayerEntryType type;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    class Layer {
+    public:
+        Layer(std::filesystem::path path, std::shared_ptr<GzipStream> stream, std::vector<LayerEntry> entries);
+
+    public:
+        [[nodiscard]] bool compressed() const;
+        [[nodiscard]] std::span<const LayerEntry> entries() const;
+        [[nodiscard]] const LayerEntry *find(std::string_view name) const;
+
+    public:
+        [[nodiscard]] std::optional<Reader> open(std::string_view name) const;
+
+    private:
+        [[nodiscard]] const LayerEntry *resolve(std::string_view name) const;
+
+    private:
+        std::filesystem::path mPath;
+        std::shared_ptr<GzipStream> mStream;
+        std::vector<LayerEntry> mEntries;
+        std::unordered_map<std::string, size_t> mIndex;
+    };
+
+    std::optional<Layer> openLayer(const std::filesystem::path &path);
+}
+
+#endif //GO_SYMBOL_LAYER_H
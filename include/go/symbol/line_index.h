@@ -0,0 +1,30 @@
+#ifndef GO_SYMBOL_LINE_INDEX_H
+#define GO_SYMBOL_LINE_INDEX_H
+
+#include "file_index.h"
+
+namespace go::symbol {
+    struct PCRange {
+        uint64_t start;
+        uint64_t end;
+    };
+
+    class LineIndex {
+    public:
+        LineIndex(const SymbolTable *table, const FileIndex *files);
+
+    public:
+        std::span<const PCRange> find(uint32_t file, int line);
+        std::vector<PCRange> find(std::string_view file, int line);
+
+    private:
+        void build(uint32_t file);
+
+    private:
+        const SymbolTable *mTable;
+        const FileIndex *mFiles;
+        std::unordered_map<uint32_t, std::unordered_map<int, std::vector<PCRange>>> mLines;
+    };
+}
+
+#endif //GO_SYMBOL_LINE_INDEX_H
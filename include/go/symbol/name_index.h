@@ -0,0 +1,58 @@
+#ifndef GO_SYMBOL_NAME_INDEX_H
+#define GO_SYMBOL_NAME_INDEX_H
+
+#include "symbol.h"
+#include "string_pool.h"
+#include <unordered_map>
+
+namespace go::symbol {
+    enum NameSpace {
+        FunctionNameSpace,
+        PackageNameSpace,
+        ReceiverNameSpace,
+        MethodNameSpace,
+        GenericNameSpace,
+        NameSpaceCount
+    };
+
+    struct NameComponents {
+        uint32_t function;
+        uint32_t package;
+        uint32_t receiver;
+        uint32_t method;
+        uint32_t generic;
+    };
+
+    class NameIndex {
+    public:
+        explicit NameIndex(const SymbolTable *table, size_t threads = 0, StringPool *pool = nullptr);
+        NameIndex(const NameIndex &) = delete;
+        NameIndex(NameIndex &&) = default;
+        ~NameIndex();
+
+    public:
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] size_t size(NameSpace space) const;
+        [[nodiscard]] memory::Usage memoryUsage() const;
+
+    public:
+        [[nodiscard]] std::string_view string(NameSpace space, uint32_t id) const;
+        [[nodiscard]] std::optional<uint32_t> find(NameSpace space, std::string_view str) const;
+        [[nodiscard]] std::optional<uint32_t> poolID(NameSpace space, uint32_t id) const;
+
+    public:
+        const NameComponents &operator[](size_t index) const;
+
+    private:
+        uint32_t intern(NameSpace space, std::string_view str);
+
+    private:
+        StringPool *mPool;
+        std::vector<NameComponents> mComponents;
+        std::array<std::vector<std::string_view>, NameSpaceCount> mStrings;
+        std::array<std::unordered_map<std::string_view, uint32_t>, NameSpaceCount> mIDs;
+        std::array<std::vector<uint32_t>, NameSpaceCount> mPoolIDs;
+    };
+}
+
+#endif //GO_SYMBOL_NAME_INDEX_H
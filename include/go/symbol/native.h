@@ -0,0 +1,41 @@
+#ifndef GO_SYMBOL_NATIVE_H
+#define GO_SYMBOL_NATIVE_H
+
+#include <elf/reader.h>
+#include <optional>
+#include <vector>
+#include <string>
+
+namespace go::symbol {
+    struct NativeSymbol {
+        uint64_t start;
+        uint64_t size;
+        const char *name;
+    };
+
+    class NativeSymbolTable {
+    public:
+        NativeSymbolTable(const elf::Reader &reader, uint64_t base);
+
+    public:
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] std::optional<NativeSymbol> find(uint64_t address) const;
+
+    public:
+        NativeSymbol operator[](size_t index) const;
+
+    private:
+        struct Entry {
+            uint64_t address;
+            uint32_t size;
+            uint32_t name;
+        };
+
+    private:
+        uint64_t mBase;
+        std::string mNames;
+        std::vector<Entry> mEntries;
+    };
+}
+
+#endif //GO_SYMBOL_NATIVE_H
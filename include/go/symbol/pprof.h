@@ -0,0 +1,50 @@
+#ifndef GO_SYMBOL_PPROF_H
+#define GO_SYMBOL_PPROF_H
+
+#include "symbol.h"
+#include <deque>
+#include <ostream>
+#include <unordered_map>
+
+struct z_stream_s;
+
+namespace go::symbol {
+    class ProfileWriter {
+    public:
+        ProfileWriter(const SymbolTable *table, std::ostream &stream, bool compress = true);
+        ~ProfileWriter();
+
+    public:
+        bool sampleType(std::string_view type, std::string_view unit);
+        bool period(std::string_view type, std::string_view unit, int64_t period);
+        bool sample(std::span<const uint64_t> stack, std::span<const int64_t> values);
+        bool finish();
+
+    private:
+        uint64_t string(std::string_view str);
+        uint64_t location(uint64_t pc);
+        uint64_t function(size_t index, const Symbol &symbol);
+
+    private:
+        bool valueType(int field, std::string_view type, std::string_view unit);
+        bool message(int field, const std::string &message);
+        bool write(const void *data, size_t size);
+
+    private:
+        const SymbolTable *mTable;
+        std::ostream &mStream;
+        bool mFinished;
+        std::unique_ptr<z_stream_s> mZStream;
+        std::string mRecord;
+        std::string mMessage;
+        std::string mSubMessage;
+        std::vector<std::byte> mOutput;
+        std::vector<uint64_t> mLocationIDs;
+        std::vector<bool> mFunctions;
+        std::deque<std::string> mOwned;
+        std::unordered_map<uint64_t, uint64_t> mLocations;
+        std::unordered_map<std::string_view, uint64_t> mStrings;
+    };
+}
+
+#endif //GO_SYMBOL_PPROF_H
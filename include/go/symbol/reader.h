@@ -3,7 +3,9 @@
 
 #include "symbol.h"
 #include "interface.h"
+#include "type.h"
 #include "build_info.h"
+#include "symbolizer.h"
 
 namespace go::symbol {
     enum AccessMethod {
@@ -12,9 +14,19 @@ namespace go::symbol {
         Attached
     };
 
+    struct SymbolOptions {
+        memory::HugePage hugePage{memory::NoHugePage};
+        std::shared_ptr<memory::IAllocator> allocator;
+        std::span<std::byte> region;
+        int capabilities{FullCapability};
+        Prefault prefault{NoPrefault};
+        int prefaultCapabilities{FullCapability};
+    };
+
     class Reader {
     public:
         Reader(elf::Reader reader, std::filesystem::path path);
+        Reader(elf::Reader reader, std::filesystem::path path, std::shared_ptr<void> handle);
 
     private:
         size_t ptrSize();
@@ -22,16 +34,25 @@ namespace go::symbol {
 
     public:
         std::optional<Version> version();
+        memory::Usage memoryUsage();
 
     public:
         std::optional<BuildInfo> buildInfo();
         std::optional<seek::SymbolTable> symbols(uint64_t base = 0);
         std::optional<SymbolTable> symbols(AccessMethod method, uint64_t base = 0);
+        std::optional<SymbolTable> symbols(AccessMethod method, const SymbolOptions &options, uint64_t base = 0);
         std::optional<InterfaceTable> interfaces(uint64_t base = 0);
+        std::optional<TypeTable> types(uint64_t base = 0);
+        std::optional<NativeSymbolTable> nativeSymbols(uint64_t base = 0);
+
+    public:
+        std::optional<Symbolizer> symbolizer(AccessMethod method, uint64_t base = 0);
+        std::optional<Symbolizer> symbolizer(AccessMethod method, const SymbolOptions &options, uint64_t base = 0);
 
     private:
         elf::Reader mReader;
         std::filesystem::path mPath;
+        std::shared_ptr<void> mHandle;
     };
 
     std::optional<Reader> openFile(const std::filesystem::path &path);
@@ -0,0 +1,23 @@
+#ifndef GO_SYMBOL_SIGNAL_SAFE_H
+#define GO_SYMBOL_SIGNAL_SAFE_H
+
+#include "stack.h"
+
+namespace go::symbol {
+    class SignalSafeSymbolizer {
+    public:
+        explicit SignalSafeSymbolizer(const SymbolTable *table) noexcept;
+
+    public:
+        bool symbolize(uint64_t pc, Frame &frame) const noexcept;
+        size_t symbolize(std::span<const uint64_t> pcs, std::span<Frame> frames) const noexcept;
+
+    public:
+        static size_t format(const Frame &frame, std::span<char> buffer) noexcept;
+
+    private:
+        const SymbolTable *mTable;
+    };
+}
+
+#endif //GO_SYMBOL_SIGNAL_SAFE_H
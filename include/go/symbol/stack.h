@@ -0,0 +1,45 @@
+#ifndef GO_SYMBOL_STACK_H
+#define GO_SYMBOL_STACK_H
+
+#include "symbol.h"
+#include <unordered_map>
+
+namespace go::symbol {
+    struct Frame {
+        uint64_t pc;
+        uint64_t entry;
+        const char *name;
+        const char *file;
+        int line;
+    };
+
+    class StackSymbolizer {
+    public:
+        explicit StackSymbolizer(const SymbolTable *table);
+
+    public:
+        uint32_t add(std::span<const uint64_t> stack);
+        void symbolize();
+
+    public:
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] const Frame &frame(uint32_t id) const;
+        [[nodiscard]] std::vector<uint32_t> stack(uint32_t id) const;
+
+    private:
+        struct Node {
+            uint32_t parent;
+            uint32_t frame;
+        };
+
+    private:
+        const SymbolTable *mTable;
+        size_t mSymbolized;
+        std::vector<Node> mNodes;
+        std::vector<Frame> mFrames;
+        std::unordered_map<uint64_t, uint32_t> mPCs;
+        std::unordered_map<uint64_t, uint32_t> mChildren;
+    };
+}
+
+#endif //GO_SYMBOL_STACK_H
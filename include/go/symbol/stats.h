@@ -0,0 +1,92 @@
+#ifndef GO_SYMBOL_STATS_H
+#define GO_SYMBOL_STATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+namespace go::symbol {
+    enum Counter {
+        LookupCounter,
+        MissCounter,
+        PCValueByteCounter,
+        VarIntCounter,
+        SeekCounter,
+        ReadCounter,
+        CacheHitCounter,
+        CounterCount
+    };
+
+    enum Operation {
+        FindOperation,
+        ValueOperation,
+        ReadOperation,
+        OperationCount
+    };
+
+    constexpr auto HISTOGRAM_SUB_BITS = 2;
+    constexpr auto HISTOGRAM_MAX_BITS = 40;
+    constexpr auto HISTOGRAM_BUCKETS = (HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BITS + 1) << HISTOGRAM_SUB_BITS;
+
+    struct Histogram {
+        uint64_t count;
+        uint64_t sum;
+        std::array<uint64_t, HISTOGRAM_BUCKETS> buckets;
+
+        [[nodiscard]] uint64_t percentile(double q) const;
+
+        static size_t bucket(uint64_t value);
+        static uint64_t upperBound(size_t bucket);
+    };
+
+    struct Snapshot {
+        std::array<uint64_t, CounterCount> counters;
+        std::array<Histogram, OperationCount> latencies;
+    };
+
+    class Stats {
+    public:
+        void add(Counter counter, uint64_t n = 1);
+        void record(Operation operation, uint64_t nanoseconds);
+
+    public:
+        [[nodiscard]] Snapshot snapshot() const;
+
+    private:
+        static size_t shard();
+
+    private:
+        struct alignas(64) Shard {
+            std::array<std::atomic<uint64_t>, CounterCount> counters;
+            std::array<std::atomic<uint64_t>, OperationCount> sums;
+            std::array<std::array<std::atomic<uint64_t>, HISTOGRAM_BUCKETS>, OperationCount> buckets;
+        };
+
+        std::array<Shard, 8> mShards{};
+    };
+
+    class Timer {
+    public:
+        Timer(Stats *stats, Operation operation);
+        ~Timer();
+
+    private:
+        Stats *mStats;
+        Operation mOperation;
+        std::chrono::steady_clock::time_point mStart;
+    };
+
+    std::string prometheus(const Snapshot &snapshot, std::string_view prefix = "go_symbol");
+}
+
+#ifdef GO_SYMBOL_ENABLE_STATS
+#define GO_SYMBOL_STATS_ADD(stats, counter, n) (stats)->add(counter, n)
+#define GO_SYMBOL_STATS_TIMER(stats, operation) go::symbol::Timer _timer(stats, operation)
+#else
+#define GO_SYMBOL_STATS_ADD(stats, counter, n) ((void) 0)
+#define GO_SYMBOL_STATS_TIMER(stats, operation) ((void) 0)
+#endif
+
+#endif //GO_SYMBOL_STATS_H
@@ -0,0 +1,58 @@
+#ifndef GO_SYMBOL_STRING_POOL_H
+#define GO_SYMBOL_STRING_POOL_H
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace go::symbol {
+    struct StringPoolUsage {
+        size_t strings;
+        size_t bytes;
+        size_t references;
+        size_t referencedBytes;
+    };
+
+    class StringPool {
+    public:
+        StringPool();
+        StringPool(const StringPool &) = delete;
+
+    public:
+        StringPool &operator=(const StringPool &) = delete;
+
+    public:
+        uint32_t acquire(std::string_view str);
+        void retain(uint32_t id);
+        void release(uint32_t id);
+
+    public:
+        [[nodiscard]] std::string_view string(uint32_t id) const;
+        [[nodiscard]] StringPoolUsage usage() const;
+
+    public:
+        static StringPool &global();
+
+    private:
+        struct Entry {
+            std::unique_ptr<char[]> data;
+            uint32_t size;
+            uint32_t references;
+        };
+
+        struct Shard {
+            mutable std::shared_mutex mutex;
+            std::vector<Entry> entries;
+            std::vector<uint32_t> free;
+            std::unordered_map<std::string_view, uint32_t> ids;
+        };
+
+    private:
+        std::unique_ptr<Shard[]> mShards;
+    };
+}
+
+#endif //GO_SYMBOL_STRING_POOL_H
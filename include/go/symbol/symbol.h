@@ -1,9 +1,13 @@
 #ifndef GO_SYMBOL_SYMBOL_H
 #define GO_SYMBOL_SYMBOL_H
 
+#include <array>
+#include <mutex>
 #include <variant>
 #include <elf/reader.h>
 #include <go/endian.h>
+#include <go/memory.h>
+#include <go/symbol/stats.h>
 #include <fstream>
 
 namespace go::symbol {
@@ -14,20 +18,110 @@ namespace go::symbol {
         VERSION120
     };
 
+    enum Capability {
+        NameCapability = 0x1,
+        PCValueCapability = 0x2,
+        FileCapability = 0x4,
+        FullCapability = NameCapability | PCValueCapability | FileCapability
+    };
+
+    enum SymbolRegion {
+        FuncNameRegion,
+        CuRegion,
+        FileRegion,
+        PCRegion,
+        FuncRegion,
+        RegionCount
+    };
+
+    enum Prefault {
+        NoPrefault,
+        WillNeedPrefault,
+        PopulatePrefault,
+        LockPrefault
+    };
+
+    struct Residency {
+        size_t pages;
+        size_t resident;
+    };
+
+    enum Attribute {
+        StackTopAttribute = 0x1,
+        WrapperAttribute = 0x2,
+        RuntimeAttribute = 0x4,
+        AsmAttribute = 0x8
+    };
+
+    struct TableLayout {
+        bool swap;
+        uint32_t size;
+        uint32_t firstShift;
+        uint32_t secondShift;
+        uint64_t secondMask;
+    };
+
+    enum PCTable {
+        PCSPTable = 4,
+        PCFileTable = 5,
+        PCLineTable = 6
+    };
+
+    class PCValue {
+    public:
+        PCValue(const std::byte *buffer, uint64_t entry, uint32_t quantum) noexcept;
+
+    public:
+        bool next() noexcept;
+
+    public:
+        [[nodiscard]] int value() const noexcept;
+        [[nodiscard]] uint64_t start() const noexcept;
+        [[nodiscard]] uint64_t end() const noexcept;
+        [[nodiscard]] size_t consumed() const noexcept;
+
+    private:
+        int mValue;
+        bool mDone;
+        uint32_t mQuantum;
+        uint64_t mStart;
+        uint64_t mEnd;
+        const std::byte *mOrigin;
+        const std::byte *mPosition;
+    };
+
     class SymbolEntry;
     class SymbolIterator;
 
+    class CompressedSection;
+
     class SymbolTable {
-        using MemoryBuffer = std::variant<std::shared_ptr<elf::ISection>, std::unique_ptr<std::byte[]>, const std::byte *>;
+        using MemoryBuffer = std::variant<std::shared_ptr<elf::ISection>, memory::Buffer, const std::byte *>;
     public:
         SymbolTable(SymbolVersion version, endian::Converter converter, MemoryBuffer memoryBuffer, uint64_t base);
 
+    private:
+        SymbolTable(const SymbolTable &table, memory::Buffer buffer, int capabilities);
+
     public:
         [[nodiscard]] SymbolIterator find(uint64_t address) const;
         [[nodiscard]] SymbolIterator find(std::string_view name) const;
 
     public:
         [[nodiscard]] size_t size() const;
+        [[nodiscard]] bool hugePage() const;
+        [[nodiscard]] int capabilities() const;
+        [[nodiscard]] Snapshot stats() const;
+        [[nodiscard]] std::span<const uint8_t> attributes() const;
+        [[nodiscard]] memory::Usage memoryUsage() const;
+
+    public:
+        [[nodiscard]] std::optional<SymbolTable>
+        compact(int capabilities, const std::function<std::optional<memory::Buffer>(size_t)> &allocate) const;
+
+    public:
+        [[nodiscard]] bool prefault(Prefault prefault, int capabilities = FullCapability) const;
+        [[nodiscard]] std::optional<std::array<Residency, RegionCount>> residency() const;
 
     public:
         [[nodiscard]] SymbolEntry operator[](size_t index) const;
@@ -36,20 +130,37 @@ namespace go::symbol {
         [[nodiscard]] SymbolIterator begin() const;
         [[nodiscard]] SymbolIterator end() const;
 
+    private:
+        [[nodiscard]] std::ptrdiff_t search(uint64_t address) const noexcept;
+
+    private:
+        [[nodiscard]] const char *file(uint32_t key) const;
+        [[nodiscard]] std::vector<std::pair<uint32_t, std::string_view>> files() const;
+
     private:
         [[nodiscard]] const std::byte *data() const;
+        [[nodiscard]] size_t wordSize() const;
+        [[nodiscard]] size_t memorySize() const;
+        [[nodiscard]] std::span<const std::byte> region(SymbolRegion region) const;
+        [[nodiscard]] std::vector<SymbolRegion> regions(int capabilities) const;
+
+    private:
+        void classify() const;
 
     private:
         uint64_t mBase;
         SymbolVersion mVersion;
         MemoryBuffer mMemoryBuffer;
         endian::Converter mConverter;
+        TableLayout mLayout{};
 
     private:
         uint32_t mQuantum{};
         uint32_t mPtrSize{};
         uint32_t mFuncNum{};
         uint32_t mFileNum{};
+        size_t mFuncNameSize{};
+        int mCapabilities{FullCapability};
 
     private:
         const std::byte *mFuncNameTable{};
@@ -59,14 +170,27 @@ namespace go::symbol {
         const std::byte *mPCTable{};
         const std::byte *mFileTable{};
 
+    private:
+        mutable std::vector<uint8_t> mAttributes;
+        std::unique_ptr<std::once_flag> mClassified{std::make_unique<std::once_flag>()};
+
+#ifdef GO_SYMBOL_ENABLE_STATS
+        std::unique_ptr<Stats> mStats{std::make_unique<Stats>()};
+#endif
+
         friend class Symbol;
         friend class SymbolEntry;
         friend class SymbolIterator;
+        friend class Exporter;
+        friend class FileIndex;
+        friend class StackSymbolizer;
+        friend class SignalSafeSymbolizer;
+        friend class BatchSymbolizer;
     };
 
     class Symbol {
     public:
-        Symbol(const SymbolTable *table, const std::byte *buffer);
+        Symbol(const SymbolTable *table, const std::byte *buffer, size_t index);
 
     public:
         [[nodiscard]] uint64_t entry() const;
@@ -78,22 +202,42 @@ namespace go::symbol {
         [[nodiscard]] const char *sourceFile(uint64_t pc) const;
 
     public:
+        void frameSizes(std::span<const uint64_t> sortedPCs, std::span<int> out) const;
+        void sourceLines(std::span<const uint64_t> sortedPCs, std::span<int> out) const;
+        void sourceFiles(std::span<const uint64_t> sortedPCs, std::span<const char *> out) const;
+
+    public:
+        [[nodiscard]] PCValue pcValue(PCTable table) const;
+        void lines(const std::function<void(uint64_t, uint64_t, std::optional<uint32_t>, int)> &callback) const;
+
+    public:
+        [[nodiscard]] int attributes() const;
         [[nodiscard]] bool isStackTop() const;
 
     private:
         [[nodiscard]] uint32_t field(int n) const;
+        [[nodiscard]] uint8_t flag() const;
+        [[nodiscard]] uint8_t classify() const;
+        [[nodiscard]] std::optional<uint32_t> fileKey(int n) const;
 
     private:
         [[nodiscard]] int value(uint32_t offset, uint64_t entry, uint64_t target) const;
+        void values(uint32_t offset, uint64_t entry, std::span<const uint64_t> targets, std::span<int> out) const;
 
     private:
         const std::byte *mBuffer;
         const SymbolTable *mTable;
+        size_t mIndex;
+
+        friend class SymbolTable;
+        friend class FileIndex;
+        friend class SignalSafeSymbolizer;
+        friend class BatchSymbolizer;
     };
 
     class SymbolEntry {
     public:
-        SymbolEntry(const SymbolTable *table, uint64_t entry, uint64_t offset);
+        SymbolEntry(const SymbolTable *table, uint64_t entry, uint64_t offset, size_t index);
 
     public:
         [[nodiscard]] uint64_t entry() const;
@@ -102,6 +246,7 @@ namespace go::symbol {
     private:
         uint64_t mEntry;
         uint64_t mOffset;
+        size_t mIndex;
         const SymbolTable *mTable;
     };
 
@@ -153,12 +298,34 @@ namespace go::symbol {
                     uint64_t base
             );
 
+            SymbolTable(
+                    SymbolVersion version,
+                    endian::Converter converter,
+                    std::shared_ptr<CompressedSection> section,
+                    uint64_t address,
+                    uint64_t base
+            );
+
+        private:
+            SymbolTable(
+                    SymbolVersion version,
+                    endian::Converter converter,
+                    std::ifstream stream,
+                    std::shared_ptr<CompressedSection> section,
+                    std::streamoff offset,
+                    uint64_t address,
+                    uint64_t base
+            );
+
         public:
             SymbolIterator find(uint64_t address);
             SymbolIterator find(std::string_view name);
 
         public:
-            size_t size() const;
+            [[nodiscard]] bool valid() const;
+            [[nodiscard]] size_t size() const;
+            [[nodiscard]] Snapshot stats() const;
+            [[nodiscard]] memory::Usage memoryUsage() const;
 
         public:
             SymbolEntry operator[](size_t index);
@@ -167,14 +334,46 @@ namespace go::symbol {
             SymbolIterator begin();
             SymbolIterator end();
 
+        private:
+            bool pack();
+            [[nodiscard]] size_t wordSize() const;
+            [[nodiscard]] uint64_t pc(size_t index) const;
+            [[nodiscard]] uint64_t funcOffset(size_t index) const;
+
+        private:
+            void seek(uint64_t address);
+            size_t read(uint64_t address, void *buffer, size_t length);
+            size_t read(void *buffer, size_t length);
+            std::string readString(uint64_t address);
+
+        private:
+            struct FuncTableBlock {
+                uint32_t pc;
+                uint32_t offset;
+                int32_t pcStride;
+                int32_t offsetStride;
+                uint32_t position;
+                uint8_t pcBits;
+                uint8_t pcShift;
+                uint8_t offsetBits;
+                uint8_t offsetShift;
+            };
+
         private:
             uint64_t mBase;
             uint64_t mAddress;
             std::streamoff mOffset;
             std::ifstream mStream;
+            std::shared_ptr<CompressedSection> mSection;
             SymbolVersion mVersion;
             endian::Converter mConverter;
-            std::unique_ptr<std::byte[]> mFuncTableBuffer;
+            TableLayout mLayout{};
+
+        private:
+            bool mValid{};
+            uint64_t mEntryBase{};
+            std::vector<FuncTableBlock> mBlocks;
+            std::vector<std::byte> mPacked;
 
         private:
             uint32_t mQuantum{};
@@ -190,6 +389,10 @@ namespace go::symbol {
             uint64_t mPCTable{};
             uint64_t mFileTable{};
 
+#ifdef GO_SYMBOL_ENABLE_STATS
+            std::unique_ptr<Stats> mStats{std::make_unique<Stats>()};
+#endif
+
             friend class Symbol;
             friend class SymbolEntry;
             friend class SymbolIterator;
@@ -208,14 +411,21 @@ namespace go::symbol {
             [[nodiscard]] int sourceLine(uint64_t pc) const;
             [[nodiscard]] std::string sourceFile(uint64_t pc) const;
 
+        public:
+            void frameSizes(std::span<const uint64_t> sortedPCs, std::span<int> out) const;
+            void sourceLines(std::span<const uint64_t> sortedPCs, std::span<int> out) const;
+            void sourceFiles(std::span<const uint64_t> sortedPCs, std::span<std::string> out) const;
+
         public:
             [[nodiscard]] bool isStackTop() const;
 
         private:
             [[nodiscard]] uint32_t field(int n) const;
+            [[nodiscard]] std::string file(int n) const;
 
         private:
             [[nodiscard]] int value(uint32_t offset, uint64_t entry, uint64_t target) const;
+            void values(uint32_t offset, uint64_t entry, std::span<const uint64_t> targets, std::span<int> out) const;
 
         private:
             uint64_t mAddress;
@@ -245,7 +455,7 @@ namespace go::symbol {
             using iterator_category = std::random_access_iterator_tag;
 
         public:
-            SymbolIterator(SymbolTable *table, const std::byte *buffer);
+            SymbolIterator(SymbolTable *table, size_t index);
 
         public:
             SymbolEntry operator*();
@@ -263,9 +473,8 @@ namespace go::symbol {
             std::ptrdiff_t operator-(const SymbolIterator &rhs);
 
         private:
-            size_t mSize;
+            size_t mIndex;
             SymbolTable *mTable;
-            const std::byte *mBuffer;
         };
     }
 }
@@ -0,0 +1,25 @@
+#ifndef GO_SYMBOL_SYMBOLIZER_H
+#define GO_SYMBOL_SYMBOLIZER_H
+
+#include "stack.h"
+#include "native.h"
+
+namespace go::symbol {
+    class Symbolizer {
+    public:
+        Symbolizer(SymbolTable symbols, std::optional<NativeSymbolTable> native);
+
+    public:
+        [[nodiscard]] std::optional<Frame> symbolize(uint64_t pc) const;
+
+    public:
+        [[nodiscard]] const SymbolTable &symbols() const;
+        [[nodiscard]] const std::optional<NativeSymbolTable> &native() const;
+
+    private:
+        SymbolTable mSymbols;
+        std::optional<NativeSymbolTable> mNative;
+    };
+}
+
+#endif //GO_SYMBOL_SYMBOLIZER_H
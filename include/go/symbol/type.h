@@ -0,0 +1,133 @@
+#ifndef GO_SYMBOL_TYPE_H
+#define GO_SYMBOL_TYPE_H
+
+#include <go/arena.h>
+#include <go/endian.h>
+#include <go/version.h>
+#include <elf/reader.h>
+
+namespace go::symbol {
+    enum TypeKind {
+        InvalidKind,
+        BoolKind,
+        IntKind,
+        Int8Kind,
+        Int16Kind,
+        Int32Kind,
+        Int64Kind,
+        UintKind,
+        Uint8Kind,
+        Uint16Kind,
+        Uint32Kind,
+        Uint64Kind,
+        UintptrKind,
+        Float32Kind,
+        Float64Kind,
+        Complex64Kind,
+        Complex128Kind,
+        ArrayKind,
+        ChanKind,
+        FuncKind,
+        InterfaceKind,
+        MapKind,
+        PointerKind,
+        SliceKind,
+        StringKind,
+        StructKind,
+        UnsafePointerKind
+    };
+
+    struct TypeField;
+
+    struct Type {
+        uint64_t offset;
+        uint64_t size;
+        uint64_t ptrData;
+        TypeKind kind;
+        std::string_view name{};
+        std::span<const TypeField> fields{};
+        bool decoded{};
+    };
+
+    struct TypeField {
+        std::string_view name;
+        uint64_t type;
+        uint64_t offset;
+        bool embedded;
+    };
+
+    class TypeTable {
+    public:
+        TypeTable(
+                elf::Reader reader,
+                std::shared_ptr<elf::ISection> section,
+                Version version,
+                uint64_t types,
+                uint64_t etypes,
+                uint64_t base,
+                size_t ptrSize,
+                endian::Converter converter
+        );
+
+        TypeTable(
+                elf::Reader reader,
+                std::span<const std::byte> links,
+                Version version,
+                uint64_t types,
+                uint64_t etypes,
+                uint64_t base,
+                size_t ptrSize,
+                endian::Converter converter
+        );
+
+    public:
+        // Enumeration walks .typelink only: types the linker left out of it are reachable
+        // through find(), lookup() and key()/elem()/fields(), but never through operator[].
+        [[nodiscard]] size_t size() const;
+
+    public:
+        const Type *operator[](size_t index);
+
+    public:
+        const Type *find(uint64_t address);
+        const Type *lookup(uint64_t offset);
+
+    public:
+        const Type *key(const Type *type);
+        const Type *elem(const Type *type);
+        std::optional<uint64_t> length(const Type *type);
+        std::span<const TypeField> fields(const Type *type);
+
+    public:
+        [[nodiscard]] uint64_t address(const Type *type) const;
+
+    private:
+        [[nodiscard]] const std::byte *memory(uint64_t offset) const;
+        [[nodiscard]] std::optional<std::pair<std::string_view, bool>> name(const std::byte *buffer) const;
+
+    private:
+        const Type *reference(const Type *type, size_t index);
+
+    private:
+        Type **slot(uint64_t offset);
+        void insert(Type *type);
+
+    private:
+        elf::Reader mReader;
+        std::shared_ptr<elf::ISection> mSection;
+        std::span<const std::byte> mLinks;
+        Version mVersion;
+        uint64_t mTypes;
+        uint64_t mETypes;
+        uint64_t mBase;
+        size_t mPtrSize;
+        endian::Converter mConverter;
+
+    private:
+        Arena mArena;
+        size_t mCount{};
+        std::span<Type *> mSlots;
+    };
+}
+
+#endif //GO_SYMBOL_TYPE_H
@@ -0,0 +1,35 @@
+#include <go/arena.h>
+#include <cstdint>
+
+go::Arena::Arena(size_t chunkSize) : mChunkSize(chunkSize), mOffset(chunkSize), mCapacity(0) {
+
+}
+
+void *go::Arena::allocate(size_t size, size_t alignment) {
+    size_t offset = (mOffset + alignment - 1) & ~(alignment - 1);
+
+    if (!mChunks.empty() && offset + size <= mChunkSize) {
+        mOffset = offset + size;
+        return mChunks.back().get() + offset;
+    }
+
+    if (size + alignment > mChunkSize) {
+        auto chunk = std::make_unique<std::byte[]>(size + alignment);
+        auto ptr = (std::byte *) (((uintptr_t) chunk.get() + alignment - 1) & ~(alignment - 1));
+
+        mCapacity += size + alignment;
+        mChunks.insert(mChunks.empty() ? mChunks.end() : mChunks.end() - 1, std::move(chunk));
+
+        return ptr;
+    }
+
+    mCapacity += mChunkSize;
+    mChunks.push_back(std::make_unique<std::byte[]>(mChunkSize));
+    mOffset = size;
+
+    return mChunks.back().get();
+}
+
+size_t go::Arena::capacity() const {
+    return mCapacity;
+}
@@ -3,18 +3,37 @@
 constexpr auto MAX_VAR_INT_LENGTH = 10;
 
 std::optional<std::pair<int64_t, int>> go::binary::varInt(const std::byte *buffer) {
-    std::optional<std::pair<uint64_t, int>> result = uVarInt(buffer);
+    int64_t value;
+    const std::byte *ptr = varInt(buffer, value);
 
-    if (!result)
+    if (!ptr)
         return std::nullopt;
 
-    if (result->first & 1)
-        return std::pair<int64_t, int>{~(result->first >> 1), result->second};
-
-    return std::pair<int64_t, int>{result->first >> 1, result->second};
+    return std::pair<int64_t, int>{value, int(ptr - buffer)};
 }
 
 std::optional<std::pair<uint64_t, int>> go::binary::uVarInt(const std::byte *buffer) {
+    uint64_t value;
+    const std::byte *ptr = uVarInt(buffer, value);
+
+    if (!ptr)
+        return std::nullopt;
+
+    return std::pair<uint64_t, int>{value, int(ptr - buffer)};
+}
+
+const std::byte *go::binary::varInt(const std::byte *buffer, int64_t &value) noexcept {
+    uint64_t v;
+    const std::byte *ptr = uVarInt(buffer, v);
+
+    if (!ptr)
+        return nullptr;
+
+    value = v & 1 ? int64_t(~(v >> 1)) : int64_t(v >> 1);
+    return ptr;
+}
+
+const std::byte *go::binary::uVarInt(const std::byte *buffer, uint64_t &value) noexcept {
     uint64_t v = 0;
     uint32_t shift = 0;
 
@@ -23,14 +42,15 @@ std::optional<std::pair<uint64_t, int>> go::binary::uVarInt(const std::byte *buf
 
         if (b < 0x80) {
             if (i == MAX_VAR_INT_LENGTH - 1 && b > 1)
-                return std::nullopt;
+                return nullptr;
 
-            return std::pair<uint64_t, int>{v | b << shift, i + 1};
+            value = v | b << shift;
+            return buffer + i + 1;
         }
 
         v |= (b & 0x7f) << shift;
         shift += 7;
     }
 
-    return std::nullopt;
-}
\ No newline at end of file
+    return nullptr;
+}
@@ -0,0 +1,202 @@
+#include <go/memory.h>
+#include <zero/log.h>
+#include <sys/mman.h>
+#include <fstream>
+#include <cstring>
+#include <cinttypes>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+#ifndef PAGE_SIZE
+#define PAGE_SIZE 0x1000
+#endif
+
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << 26)
+#endif
+
+constexpr auto HUGE_PAGE_SIZE = 0x200000;
+constexpr auto SMAPS_PATH = "/proc/self/smaps";
+
+go::memory::Buffer::Buffer(
+        std::byte *data,
+        size_t size,
+        HugePage hugePage,
+        std::function<void(std::byte *, size_t)> release,
+        Backing backing
+) : mData(data), mSize(size), mHugePage(hugePage), mBacking(backing), mRelease(std::move(release)) {
+
+}
+
+go::memory::Buffer::Buffer(go::memory::Buffer &&rhs) noexcept
+        : mData(std::exchange(rhs.mData, nullptr)), mSize(std::exchange(rhs.mSize, 0)), mHugePage(rhs.mHugePage),
+          mBacking(rhs.mBacking), mRelease(std::move(rhs.mRelease)) {
+
+}
+
+go::memory::Buffer::~Buffer() {
+    if (mData && mRelease)
+        mRelease(mData, mSize);
+}
+
+go::memory::Buffer &go::memory::Buffer::operator=(go::memory::Buffer &&rhs) noexcept {
+    if (this == &rhs)
+        return *this;
+
+    if (mData && mRelease)
+        mRelease(mData, mSize);
+
+    mData = std::exchange(rhs.mData, nullptr);
+    mSize = std::exchange(rhs.mSize, 0);
+    mHugePage = rhs.mHugePage;
+    mBacking = rhs.mBacking;
+    mRelease = std::move(rhs.mRelease);
+
+    return *this;
+}
+
+std::byte *go::memory::Buffer::data() const {
+    return mData;
+}
+
+size_t go::memory::Buffer::size() const {
+    return mSize;
+}
+
+bool go::memory::Buffer::hugePage() const {
+    if (mHugePage == ExplicitHugePage)
+        return true;
+
+    std::ifstream stream(SMAPS_PATH);
+
+    if (!stream.is_open())
+        return false;
+
+    bool inside = false;
+    auto address = (uintptr_t) mData;
+
+    std::string line;
+
+    while (std::getline(stream, line)) {
+        uintptr_t start, end;
+
+        if (sscanf(line.c_str(), "%" SCNxPTR "-%" SCNxPTR, &start, &end) == 2) {
+            if (inside)
+                break;
+
+            inside = address >= start && address < end;
+            continue;
+        }
+
+        if (!inside)
+            continue;
+
+        size_t value;
+
+        if (sscanf(line.c_str(), "AnonHugePages: %zu kB", &value) == 1 && value > 0)
+            return true;
+
+        if (sscanf(line.c_str(), "KernelPageSize: %zu kB", &value) == 1 && value * 1024 >= HUGE_PAGE_SIZE)
+            return true;
+    }
+
+    return false;
+}
+
+go::memory::Backing go::memory::Buffer::backing() const {
+    return mBacking;
+}
+
+std::optional<go::memory::Buffer> go::memory::allocate(size_t size, HugePage hugePage) {
+    if (hugePage == NoHugePage) {
+        auto data = new(std::nothrow) std::byte[size];
+
+        if (!data)
+            return std::nullopt;
+
+        return Buffer(data, size, NoHugePage, [](std::byte *ptr, size_t) {
+            delete[] ptr;
+        });
+    }
+
+    size_t length = (size + HUGE_PAGE_SIZE - 1) & ~size_t(HUGE_PAGE_SIZE - 1);
+
+    if (hugePage == ExplicitHugePage) {
+        void *ptr = mmap(
+                nullptr,
+                length,
+                PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_2MB,
+                -1,
+                0
+        );
+
+        if (ptr != MAP_FAILED)
+            return Buffer((std::byte *) ptr, size, ExplicitHugePage, [=](std::byte *ptr, size_t) {
+                munmap(ptr, length);
+            });
+
+        LOG_WARNING("allocate explicit huge pages failed: %s", strerror(errno));
+    }
+
+    void *ptr = mmap(nullptr, length + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (ptr == MAP_FAILED) {
+        LOG_ERROR("allocate memory failed: %s", strerror(errno));
+        return std::nullopt;
+    }
+
+    auto start = (uintptr_t) ptr;
+    uintptr_t aligned = (start + HUGE_PAGE_SIZE - 1) & ~uintptr_t(HUGE_PAGE_SIZE - 1);
+
+    if (aligned > start)
+        munmap(ptr, aligned - start);
+
+    if (start + HUGE_PAGE_SIZE > aligned)
+        munmap((void *) (aligned + length), start + HUGE_PAGE_SIZE - aligned);
+
+    if (madvise((void *) aligned, length, MADV_HUGEPAGE) < 0)
+        LOG_WARNING("advise transparent huge pages failed: %s", strerror(errno));
+
+    return Buffer((std::byte *) aligned, size, TransparentHugePage, [=](std::byte *ptr, size_t) {
+        munmap(ptr, length);
+    });
+}
+
+std::optional<go::memory::Buffer> go::memory::allocate(size_t size, const std::shared_ptr<IAllocator> &allocator) {
+    std::byte *data = allocator->allocate(size);
+
+    if (!data)
+        return std::nullopt;
+
+    return Buffer(data, size, NoHugePage, [=](std::byte *ptr, size_t size) {
+        allocator->deallocate(ptr, size);
+    });
+}
+
+std::optional<go::memory::Buffer> go::memory::borrow(std::span<std::byte> region, size_t size) {
+    if (region.size() < size)
+        return std::nullopt;
+
+    return Buffer(region.data(), size, NoHugePage, nullptr);
+}
+
+std::optional<size_t> go::memory::resident(std::span<const std::byte> region) {
+    if (region.empty())
+        return 0;
+
+    auto start = (uintptr_t) region.data() & ~uintptr_t(PAGE_SIZE - 1);
+    size_t length = (uintptr_t) region.data() + region.size() - start;
+
+    std::vector<unsigned char> vec((length + PAGE_SIZE - 1) / PAGE_SIZE);
+
+    if (mincore((void *) start, length, vec.data()) < 0) {
+        LOG_ERROR("query memory residency failed: %s", strerror(errno));
+        return std::nullopt;
+    }
+
+    return PAGE_SIZE * std::count_if(vec.begin(), vec.end(), [](unsigned char c) {
+        return c & 1;
+    });
+}
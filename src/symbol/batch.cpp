@@ -0,0 +1,129 @@
+#include <go/symbol/batch.h>
+#include <algorithm>
+
+constexpr auto DEADLINE_CHECK_INTERVAL = 64;
+
+go::symbol::BatchSymbolizer::BatchSymbolizer(const SymbolTable *table, std::span<const uint64_t> pcs)
+        : mNext(0), mTable(table), mFrames(pcs.size()), mOrder(pcs.size()), mStates(pcs.size(), PendingFrame) {
+    for (size_t i = 0; i < pcs.size(); i++) {
+        mFrames[i] = {pcs[i], 0, nullptr, nullptr, -1};
+        mOrder[i] = uint32_t(i);
+    }
+
+    std::sort(mOrder.begin(), mOrder.end(), [&](uint32_t lhs, uint32_t rhs) {
+        return pcs[lhs] < pcs[rhs];
+    });
+}
+
+bool go::symbol::BatchSymbolizer::resume(const WorkBudget &budget) {
+    size_t decoded = 0;
+    size_t steps = 0;
+
+    auto expired = [&]() {
+        return budget.deadline && std::chrono::steady_clock::now() >= *budget.deadline;
+    };
+
+    auto exhausted = [&]() {
+        return budget.bytes && decoded >= *budget.bytes;
+    };
+
+    auto advance = [&](PCValue &value, uint64_t target) {
+        while (target >= value.end()) {
+            size_t consumed = value.consumed();
+
+            if (!value.next())
+                return true;
+
+            decoded += value.consumed() - consumed;
+
+            if (exhausted() || (++steps % DEADLINE_CHECK_INTERVAL == 0 && expired()))
+                return false;
+        }
+
+        return true;
+    };
+
+    int capabilities = mTable->capabilities();
+
+    while (mNext < mOrder.size()) {
+        if (exhausted() || expired())
+            return false;
+
+        uint32_t index = mOrder[mNext];
+        Frame &frame = mFrames[index];
+
+        if (mCursor && frame.pc >= mCursor->end)
+            mCursor.reset();
+
+        if (!mCursor) {
+            auto it = mTable->find(frame.pc);
+
+            if (it == mTable->end()) {
+                mStates[index] = UnresolvedFrame;
+                mNext++;
+                continue;
+            }
+
+            auto next = it + 1;
+            Symbol symbol = (*it).symbol();
+
+            mCursor = Cursor{
+                    symbol,
+                    next == mTable->end() ? UINT64_MAX : (*next).entry(),
+                    symbol.pcValue(PCLineTable),
+                    symbol.pcValue(PCFileTable)
+            };
+        }
+
+        frame.entry = mCursor->symbol.entry();
+        frame.name = mCursor->symbol.name();
+
+        if (capabilities & PCValueCapability) {
+            if (!advance(mCursor->lines, frame.pc))
+                return false;
+
+            frame.line = frame.pc < mCursor->lines.end() ? mCursor->lines.value() : -1;
+        }
+
+        if (capabilities & FileCapability) {
+            if (!advance(mCursor->files, frame.pc))
+                return false;
+
+            std::optional<uint32_t> key;
+
+            if (frame.pc < mCursor->files.end())
+                key = mCursor->symbol.fileKey(mCursor->files.value());
+
+            frame.file = key ? mTable->file(*key) : "";
+        }
+
+        mStates[index] = ResolvedFrame;
+        mNext++;
+    }
+
+    return true;
+}
+
+bool go::symbol::BatchSymbolizer::done() const {
+    return mNext == mOrder.size();
+}
+
+size_t go::symbol::BatchSymbolizer::size() const {
+    return mFrames.size();
+}
+
+size_t go::symbol::BatchSymbolizer::remaining() const {
+    return mOrder.size() - mNext;
+}
+
+bool go::symbol::BatchSymbolizer::resolved(size_t index) const {
+    return mStates[index] == ResolvedFrame;
+}
+
+go::symbol::FrameState go::symbol::BatchSymbolizer::state(size_t index) const {
+    return mStates[index];
+}
+
+const go::symbol::Frame &go::symbol::BatchSymbolizer::frame(size_t index) const {
+    return mFrames[index];
+}
@@ -0,0 +1,245 @@
+#include <go/symbol/budget.h>
+#include <algorithm>
+
+namespace {
+    template<typename T>
+    struct Indexed {
+        std::shared_ptr<go::symbol::SymbolTable> table;
+        T index;
+    };
+
+    struct Charge {
+        std::shared_ptr<go::symbol::IBudgetResource> resource;
+        size_t bytes;
+        bool exhausted;
+    };
+
+    size_t charge(const go::memory::Usage &usage) {
+        return usage.heap + usage.resident;
+    }
+}
+
+go::symbol::ManagedSymbolTable::ManagedSymbolTable(Reader reader, SymbolOptions options, uint64_t base, StringPool *pool)
+        : mBase(base), mMode(SeekTable), mReader(std::move(reader)), mOptions(std::move(options)), mPool(pool) {
+
+}
+
+bool go::symbol::ManagedSymbolTable::open(TableMode mode) {
+    std::lock_guard guard(mMutex);
+    return load(mode);
+}
+
+go::symbol::TableMode go::symbol::ManagedSymbolTable::mode() {
+    std::lock_guard guard(mMutex);
+    return mMode;
+}
+
+std::shared_ptr<const go::symbol::SymbolTable> go::symbol::ManagedSymbolTable::symbols() {
+    std::lock_guard guard(mMutex);
+    return mTable;
+}
+
+std::shared_ptr<go::symbol::seek::SymbolTable> go::symbol::ManagedSymbolTable::seekSymbols() {
+    std::lock_guard guard(mMutex);
+    return mSeekTable;
+}
+
+std::shared_ptr<const go::symbol::NameIndex> go::symbol::ManagedSymbolTable::nameIndex() {
+    std::lock_guard guard(mMutex);
+
+    if (mNameIndex || !mTable)
+        return mNameIndex;
+
+    std::shared_ptr<Indexed<NameIndex>> indexed(new Indexed<NameIndex>{mTable, NameIndex(mTable.get(), 0, mPool)});
+    mNameIndex = std::shared_ptr<const NameIndex>(indexed, &indexed->index);
+
+    return mNameIndex;
+}
+
+std::shared_ptr<const go::symbol::FileIndex> go::symbol::ManagedSymbolTable::fileIndex() {
+    std::lock_guard guard(mMutex);
+
+    if (mFileIndex || !mTable)
+        return mFileIndex;
+
+    std::shared_ptr<Indexed<FileIndex>> indexed(new Indexed<FileIndex>{mTable, FileIndex(mTable.get(), mPool)});
+    mFileIndex = std::shared_ptr<const FileIndex>(indexed, &indexed->index);
+
+    return mFileIndex;
+}
+
+go::memory::Usage go::symbol::ManagedSymbolTable::memoryUsage() {
+    std::lock_guard guard(mMutex);
+    memory::Usage usage = {};
+
+    if (mTable)
+        usage = mTable->memoryUsage();
+    else if (mSeekTable)
+        usage = mSeekTable->memoryUsage();
+
+    if (mNameIndex)
+        usage.heap += mNameIndex->memoryUsage().heap;
+
+    if (mFileIndex)
+        usage.heap += mFileIndex->memoryUsage().heap;
+
+    return usage;
+}
+
+bool go::symbol::ManagedSymbolTable::shrink() {
+    std::lock_guard guard(mMutex);
+
+    if (mFileIndex) {
+        mFileIndex.reset();
+        return true;
+    }
+
+    if (mNameIndex) {
+        mNameIndex.reset();
+        return true;
+    }
+
+    if (mMode == AnonymousTable)
+        return load(MappedTable) || load(SeekTable);
+
+    if (mMode == MappedTable)
+        return load(SeekTable);
+
+    return false;
+}
+
+bool go::symbol::ManagedSymbolTable::load(TableMode mode) {
+    if (mode == SeekTable) {
+        std::optional<seek::SymbolTable> table = mReader.symbols(mBase);
+
+        if (!table)
+            return false;
+
+        mSeekTable = std::make_shared<seek::SymbolTable>(std::move(*table));
+        mTable.reset();
+    } else {
+        std::optional<SymbolTable> table = mReader.symbols(
+                mode == AnonymousTable ? AnonymousMemory : FileMapping,
+                mOptions,
+                mBase
+        );
+
+        if (!table)
+            return false;
+
+        mTable = std::make_shared<SymbolTable>(std::move(*table));
+        mSeekTable.reset();
+    }
+
+    mNameIndex.reset();
+    mFileIndex.reset();
+    mMode = mode;
+
+    return true;
+}
+
+go::symbol::BudgetManager::BudgetManager(size_t limit) : mLimit(limit) {
+
+}
+
+void go::symbol::BudgetManager::limit(size_t limit) {
+    {
+        std::lock_guard guard(mMutex);
+        mLimit = limit;
+    }
+
+    enforce();
+}
+
+size_t go::symbol::BudgetManager::limit() {
+    std::lock_guard guard(mMutex);
+    return mLimit;
+}
+
+void go::symbol::BudgetManager::add(const std::shared_ptr<IBudgetResource> &resource) {
+    {
+        std::lock_guard guard(mMutex);
+        mResources.push_back(resource);
+    }
+
+    enforce();
+}
+
+go::memory::Usage go::symbol::BudgetManager::usage() {
+    memory::Usage usage = {};
+
+    for (const auto &resource: resources()) {
+        memory::Usage current = resource->memoryUsage();
+
+        usage.heap += current.heap;
+        usage.mapped += current.mapped;
+        usage.resident += current.resident;
+    }
+
+    return usage;
+}
+
+size_t go::symbol::BudgetManager::enforce() {
+    size_t limit = this->limit();
+
+    if (!limit)
+        return 0;
+
+    size_t total = 0;
+    std::vector<Charge> charges;
+
+    for (auto &resource: resources()) {
+        size_t bytes = charge(resource->memoryUsage());
+
+        total += bytes;
+        charges.push_back({std::move(resource), bytes, false});
+    }
+
+    size_t before = total;
+
+    while (total > limit) {
+        auto it = std::max_element(charges.begin(), charges.end(), [](const auto &lhs, const auto &rhs) {
+            return (lhs.exhausted ? 0 : lhs.bytes) < (rhs.exhausted ? 0 : rhs.bytes);
+        });
+
+        if (it == charges.end() || it->exhausted)
+            break;
+
+        if (!it->resource->shrink()) {
+            it->exhausted = true;
+            continue;
+        }
+
+        size_t bytes = charge(it->resource->memoryUsage());
+
+        total = total - it->bytes + bytes;
+        it->bytes = bytes;
+    }
+
+    return before > total ? before - total : 0;
+}
+
+std::vector<std::shared_ptr<go::symbol::IBudgetResource>> go::symbol::BudgetManager::resources() {
+    std::lock_guard guard(mMutex);
+    std::vector<std::shared_ptr<IBudgetResource>> resources;
+
+    std::erase_if(mResources, [](const auto &resource) {
+        return resource.expired();
+    });
+
+    for (const auto &resource: mResources) {
+        std::shared_ptr<IBudgetResource> ptr = resource.lock();
+
+        if (!ptr)
+            continue;
+
+        resources.push_back(std::move(ptr));
+    }
+
+    return resources;
+}
+
+go::symbol::BudgetManager &go::symbol::BudgetManager::global() {
+    static BudgetManager manager;
+    return manager;
+}
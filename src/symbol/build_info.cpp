@@ -1,4 +1,5 @@
 #include <go/symbol/build_info.h>
+#include "probe.h"
 #include <go/binary.h>
 #include <go/endian.h>
 #include <zero/log.h>
@@ -12,14 +13,19 @@ constexpr auto POINTER_FREE_OFFSET = 32;
 constexpr auto POINTER_FREE_FLAG = std::byte{0x2};
 
 go::symbol::BuildInfo::BuildInfo(elf::Reader reader, std::shared_ptr<elf::ISection> section)
-        : mReader(std::move(reader)), mSection(std::move(section)) {
-    mPtrSize = std::to_integer<size_t>(mSection->data()[MAGIC_SIZE]);
-    mEndian = std::to_integer<bool>(mSection->data()[MAGIC_SIZE + 1]) ? elf::endian::Big : elf::endian::Little;
-    mPointerFree = std::to_integer<bool>(mSection->data()[MAGIC_SIZE + 1] & POINTER_FREE_FLAG);
+        : BuildInfo(std::move(reader), section->data()) {
+    mSection = std::move(section);
+}
+
+go::symbol::BuildInfo::BuildInfo(elf::Reader reader, const std::byte *data)
+        : mReader(std::move(reader)), mData(data) {
+    mPtrSize = std::to_integer<size_t>(mData[MAGIC_SIZE]);
+    mEndian = std::to_integer<bool>(mData[MAGIC_SIZE + 1]) ? elf::endian::Big : elf::endian::Little;
+    mPointerFree = std::to_integer<bool>(mData[MAGIC_SIZE + 1] & POINTER_FREE_FLAG);
 }
 
 std::optional<go::Version> go::symbol::BuildInfo::version() {
-    const std::byte *buffer = mSection->data();
+    const std::byte *buffer = mData;
 
     if (!mPointerFree) {
         std::optional<std::string> str = readString(buffer + INFO_OFFSET);
@@ -39,7 +45,7 @@ std::optional<go::Version> go::symbol::BuildInfo::version() {
 }
 
 std::optional<go::symbol::ModuleInfo> go::symbol::BuildInfo::moduleInfo() {
-    const std::byte *buffer = mSection->data();
+    const std::byte *buffer = mData;
     std::string modInfo;
 
     if (!mPointerFree) {
@@ -113,6 +119,8 @@ std::optional<go::symbol::ModuleInfo> go::symbol::BuildInfo::moduleInfo() {
         }
     }
 
+    GO_SYMBOL_PROBE2(module_info, modInfo.length(), moduleInfo.deps.size());
+
     return moduleInfo;
 }
 
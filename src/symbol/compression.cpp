@@ -0,0 +1,572 @@
+#include "compression.h"
+#include <zero/log.h>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+
+constexpr auto ELF_COMPRESS_ZLIB = 1;
+constexpr auto ELF_COMPRESS_ZSTD = 2;
+
+constexpr auto CHDR32_SIZE = 12;
+constexpr auto CHDR64_SIZE = 24;
+
+constexpr auto CHUNK_SIZE = 256 * 1024;
+constexpr auto CACHE_CHUNKS = 4;
+constexpr auto CHECKPOINT_INTERVAL = 4 * CHUNK_SIZE;
+constexpr auto INFLATE_STATE_SIZE = 7 * 1024 + 32 * 1024;
+
+constexpr auto GZIP_WINDOW_BITS = 16 + MAX_WBITS;
+constexpr auto GZIP_MAGIC = std::byte{0x1f};
+constexpr auto GZIP_INPUT_SIZE = 128 * 1024;
+constexpr auto GZIP_OUTPUT_SIZE = 64 * 1024;
+constexpr auto GZIP_CHECKPOINT_INTERVAL = 8 * 1024 * 1024;
+
+std::optional<go::symbol::CompressedData>
+go::symbol::compressedData(const std::shared_ptr<elf::ISection> &section, endian::Converter converter, size_t ptrSize) {
+    const std::byte *data = section->data();
+    uint64_t size = section->size();
+
+    uint32_t type;
+    uint64_t length;
+    size_t header;
+
+    if (ptrSize == 8) {
+        if (size < CHDR64_SIZE) {
+            LOG_ERROR("compressed section too small");
+            return std::nullopt;
+        }
+
+        type = converter(data, 4);
+        length = converter(data + 8, 8);
+        header = CHDR64_SIZE;
+    } else {
+        if (size < CHDR32_SIZE) {
+            LOG_ERROR("compressed section too small");
+            return std::nullopt;
+        }
+
+        type = converter(data, 4);
+        length = converter(data + 4, 4);
+        header = CHDR32_SIZE;
+    }
+
+    if (type != ELF_COMPRESS_ZLIB && type != ELF_COMPRESS_ZSTD) {
+        LOG_ERROR("unsupported section compression type %u", type);
+        return std::nullopt;
+    }
+
+    return CompressedData{(CompressionType) type, length, {data + header, size - header}};
+}
+
+bool go::symbol::decompress(const CompressedData &data, std::span<std::byte> out) {
+    if (out.size() < data.size)
+        return false;
+
+    if (data.type == ZstdCompression) {
+        size_t result = ZSTD_decompress(out.data(), data.size, data.payload.data(), data.payload.size());
+
+        if (ZSTD_isError(result)) {
+            LOG_ERROR("zstd decompress failed: %s", ZSTD_getErrorName(result));
+            return false;
+        }
+
+        return result == data.size;
+    }
+
+    z_stream stream = {};
+
+    if (inflateInit(&stream) != Z_OK)
+        return false;
+
+    stream.next_in = (Bytef *) data.payload.data();
+    stream.avail_in = (uInt) data.payload.size();
+    stream.next_out = (Bytef *) out.data();
+    stream.avail_out = (uInt) data.size;
+
+    int status = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+
+    if (status != Z_STREAM_END) {
+        LOG_ERROR("zlib decompress failed: %d", status);
+        return false;
+    }
+
+    return stream.total_out == data.size;
+}
+
+go::symbol::CompressedSection::CompressedSection(std::shared_ptr<elf::ISection> section, CompressedData data)
+        : mPosition(0), mDecoded(0), mValid(false), mData(data), mSection(std::move(section)) {
+    if (mData.type == ZstdCompression) {
+        if (ZSTD_findFrameCompressedSize(mData.payload.data(), mData.payload.size()) == mData.payload.size()) {
+            mBuffer = memory::allocate(mData.size);
+            mValid = mBuffer && decompress(mData, {mBuffer->data(), mBuffer->size()});
+            return;
+        }
+
+        mZstd = ZSTD_createDStream();
+        mFrames.push_back({0, 0});
+        mValid = mZstd != nullptr;
+        return;
+    }
+
+    if (inflateInit(&mInflate) != Z_OK)
+        return;
+
+    mInflate.next_in = (Bytef *) mData.payload.data();
+    mInflate.avail_in = (uInt) mData.payload.size();
+
+    auto checkpoint = std::make_unique<z_stream>();
+
+    if (inflateCopy(checkpoint.get(), &mInflate) != Z_OK)
+        return;
+
+    mCheckpoints.push_back(std::move(checkpoint));
+    mValid = true;
+}
+
+go::symbol::CompressedSection::~CompressedSection() {
+    if (mData.type == ZstdCompression) {
+        ZSTD_freeDStream(mZstd);
+        return;
+    }
+
+    inflateEnd(&mInflate);
+
+    for (const auto &checkpoint: mCheckpoints)
+        inflateEnd(checkpoint.get());
+}
+
+uint64_t go::symbol::CompressedSection::size() const {
+    return mData.size;
+}
+
+go::memory::Usage go::symbol::CompressedSection::memoryUsage() const {
+    memory::Usage usage = {mChunks.size() * CHUNK_SIZE, mData.payload.size(), 0};
+
+    if (mBuffer)
+        usage.heap += mBuffer->size();
+    else if (mData.type == ZstdCompression)
+        usage.heap += ZSTD_sizeof_DStream(mZstd) + mFrames.capacity() * sizeof(FrameCheckpoint);
+    else
+        usage.heap += (mCheckpoints.size() + 1) * (sizeof(z_stream) + INFLATE_STATE_SIZE);
+
+    usage.resident = memory::resident(mData.payload).value_or(0);
+
+    return usage;
+}
+
+void go::symbol::CompressedSection::seek(uint64_t offset) {
+    mPosition = offset;
+}
+
+size_t go::symbol::CompressedSection::read(void *buffer, size_t length) {
+    auto *ptr = static_cast<std::byte *>(buffer);
+    size_t total = 0;
+
+    while (total < length) {
+        std::span<const std::byte> data = view();
+
+        if (data.empty())
+            break;
+
+        size_t n = std::min(length - total, data.size());
+        memcpy(ptr + total, data.data(), n);
+
+        total += n;
+        mPosition += n;
+    }
+
+    return total;
+}
+
+std::string go::symbol::CompressedSection::readString() {
+    std::string str;
+
+    while (true) {
+        std::span<const std::byte> data = view();
+
+        if (data.empty())
+            break;
+
+        const auto *begin = (const char *) data.data();
+        const auto *end = (const char *) memchr(begin, 0, data.size());
+
+        if (end) {
+            str.append(begin, end);
+            mPosition += end - begin + 1;
+            break;
+        }
+
+        str.append(begin, data.size());
+        mPosition += data.size();
+    }
+
+    return str;
+}
+
+std::span<const std::byte> go::symbol::CompressedSection::view() {
+    if (mPosition >= mData.size)
+        return {};
+
+    if (mBuffer) {
+        if (!mValid)
+            return {};
+
+        return {mBuffer->data() + mPosition, mBuffer->size() - mPosition};
+    }
+
+    const Chunk *chunk = this->chunk(mPosition / CHUNK_SIZE);
+
+    if (!chunk)
+        return {};
+
+    size_t offset = mPosition % CHUNK_SIZE;
+
+    if (offset >= chunk->size)
+        return {};
+
+    return {chunk->data.get() + offset, chunk->size - offset};
+}
+
+const go::symbol::CompressedSection::Chunk *go::symbol::CompressedSection::chunk(uint64_t index) {
+    auto it = std::find_if(mChunks.begin(), mChunks.end(), [=](const auto &chunk) {
+        return chunk.index == index;
+    });
+
+    if (it != mChunks.end()) {
+        mChunks.splice(mChunks.begin(), mChunks, it);
+        return &mChunks.front();
+    }
+
+    uint64_t start = index * CHUNK_SIZE;
+
+    if (start >= mData.size || !restore(start))
+        return nullptr;
+
+    std::unique_ptr<std::byte[]> data;
+
+    if (mChunks.size() >= CACHE_CHUNKS) {
+        data = std::move(mChunks.back().data);
+        mChunks.pop_back();
+    } else {
+        data = std::make_unique<std::byte[]>(CHUNK_SIZE);
+    }
+
+    while (mDecoded < start) {
+        if (decode(data.get(), std::min<uint64_t>(CHUNK_SIZE, start - mDecoded)) == 0) {
+            LOG_ERROR("decompress section failed");
+            return nullptr;
+        }
+    }
+
+    size_t size = std::min<uint64_t>(CHUNK_SIZE, mData.size - start);
+
+    if (decode(data.get(), size) != size) {
+        LOG_ERROR("decompress section failed");
+        return nullptr;
+    }
+
+    mChunks.push_front({index, size, std::move(data)});
+    return &mChunks.front();
+}
+
+bool go::symbol::CompressedSection::restore(uint64_t offset) {
+    if (mData.type == ZstdCompression) {
+        if (!mZstd)
+            return false;
+
+        auto it = std::prev(std::upper_bound(
+                mFrames.begin(),
+                mFrames.end(),
+                offset,
+                [](uint64_t value, const auto &frame) {
+                    return value < frame.output;
+                }
+        ));
+
+        if (mValid && mDecoded <= offset && it->output <= mDecoded)
+            return true;
+
+        ZSTD_DCtx_reset(mZstd, ZSTD_reset_session_only);
+
+        mInput = it->input;
+        mDecoded = it->output;
+        mValid = true;
+
+        return true;
+    }
+
+    if (mCheckpoints.empty())
+        return false;
+
+    size_t index = std::min<size_t>(offset / CHECKPOINT_INTERVAL, mCheckpoints.size() - 1);
+
+    if (mValid && mDecoded <= offset && index * CHECKPOINT_INTERVAL <= mDecoded)
+        return true;
+
+    inflateEnd(&mInflate);
+
+    if (inflateCopy(&mInflate, mCheckpoints[index].get()) != Z_OK) {
+        mValid = false;
+        return false;
+    }
+
+    mDecoded = index * CHECKPOINT_INTERVAL;
+    mValid = true;
+
+    return true;
+}
+
+size_t go::symbol::CompressedSection::decode(std::byte *buffer, size_t length) {
+    size_t total = 0;
+
+    while (mValid && total < length) {
+        if (mData.type == ZstdCompression) {
+            ZSTD_outBuffer output = {buffer + total, length - total, 0};
+            ZSTD_inBuffer input = {mData.payload.data(), mData.payload.size(), mInput};
+
+            size_t result = ZSTD_decompressStream(mZstd, &output, &input);
+
+            if (ZSTD_isError(result)) {
+                LOG_ERROR("zstd decompress failed: %s", ZSTD_getErrorName(result));
+                mValid = false;
+                break;
+            }
+
+            bool progress = output.pos > 0 || input.pos > mInput;
+
+            mInput = input.pos;
+            mDecoded += output.pos;
+            total += output.pos;
+
+            if (result == 0 && mInput < mData.payload.size() && mFrames.back().input < mInput)
+                mFrames.push_back({mDecoded, mInput});
+
+            if (!progress)
+                break;
+
+            continue;
+        }
+
+        size_t n = std::min<uint64_t>(length - total, CHECKPOINT_INTERVAL - mDecoded % CHECKPOINT_INTERVAL);
+
+        mInflate.next_out = (Bytef *) (buffer + total);
+        mInflate.avail_out = (uInt) n;
+
+        int status = inflate(&mInflate, Z_NO_FLUSH);
+        size_t produced = n - mInflate.avail_out;
+
+        mDecoded += produced;
+        total += produced;
+
+        if (mDecoded % CHECKPOINT_INTERVAL == 0 && mDecoded / CHECKPOINT_INTERVAL == mCheckpoints.size()) {
+            auto checkpoint = std::make_unique<z_stream>();
+
+            if (inflateCopy(checkpoint.get(), &mInflate) == Z_OK)
+                mCheckpoints.push_back(std::move(checkpoint));
+        }
+
+        if (status == Z_STREAM_END)
+            break;
+
+        if (status != Z_OK && status != Z_BUF_ERROR) {
+            LOG_ERROR("zlib decompress failed: %d", status);
+            mValid = false;
+            break;
+        }
+
+        if (produced == 0)
+            break;
+    }
+
+    return total;
+}
+
+
+go::symbol::GzipStream::GzipStream(int fd)
+        : mFD(fd), mValid(false),
+          mCursor{std::make_unique<z_stream>(), std::make_unique<std::byte[]>(GZIP_INPUT_SIZE), 0, 0, false} {
+    if (inflateInit2(mCursor.stream.get(), GZIP_WINDOW_BITS) != Z_OK) {
+        mCursor.stream.reset();
+        return;
+    }
+
+    auto checkpoint = std::make_unique<z_stream>();
+
+    if (inflateCopy(checkpoint.get(), mCursor.stream.get()) != Z_OK)
+        return;
+
+    mCheckpoints.push_back({0, std::move(checkpoint)});
+    mValid = true;
+}
+
+go::symbol::GzipStream::~GzipStream() {
+    if (mCursor.stream)
+        inflateEnd(mCursor.stream.get());
+
+    for (const auto &checkpoint: mCheckpoints)
+        inflateEnd(checkpoint.stream.get());
+
+    close(mFD);
+}
+
+bool go::symbol::GzipStream::valid() const {
+    return mValid;
+}
+
+uint64_t go::symbol::GzipStream::position() const {
+    return mCursor.output;
+}
+
+bool go::symbol::GzipStream::read(void *buffer, size_t length) {
+    auto *ptr = static_cast<std::byte *>(buffer);
+    size_t total = 0;
+
+    while (mValid && total < length) {
+        size_t n = std::min<uint64_t>(
+                length - total,
+                GZIP_CHECKPOINT_INTERVAL - mCursor.output % GZIP_CHECKPOINT_INTERVAL
+        );
+
+        size_t produced = decode(mCursor, ptr + total, n);
+        total += produced;
+
+        if (mCursor.output % GZIP_CHECKPOINT_INTERVAL == 0 &&
+            mCursor.output / GZIP_CHECKPOINT_INTERVAL == mCheckpoints.size()) {
+            auto checkpoint = std::make_unique<z_stream>();
+
+            if (inflateCopy(checkpoint.get(), mCursor.stream.get()) == Z_OK)
+                mCheckpoints.push_back({mCursor.input - mCursor.stream->avail_in, std::move(checkpoint)});
+        }
+
+        if (produced < n)
+            break;
+    }
+
+    return total == length;
+}
+
+bool go::symbol::GzipStream::skip(uint64_t length) {
+    std::unique_ptr<std::byte[]> buffer = std::make_unique<std::byte[]>(GZIP_OUTPUT_SIZE);
+
+    while (length > 0) {
+        size_t n = std::min<uint64_t>(length, GZIP_OUTPUT_SIZE);
+
+        if (!read(buffer.get(), n))
+            return false;
+
+        length -= n;
+    }
+
+    return true;
+}
+
+bool go::symbol::GzipStream::copy(
+        uint64_t offset,
+        uint64_t size,
+        const std::function<bool(std::span<const std::byte>)> &consumer
+) const {
+    std::optional<Cursor> cursor = restore(offset);
+
+    if (!cursor)
+        return false;
+
+    std::unique_ptr<std::byte[]> buffer = std::make_unique<std::byte[]>(GZIP_OUTPUT_SIZE);
+    bool result = true;
+
+    while (result && cursor->output < offset) {
+        size_t n = std::min<uint64_t>(offset - cursor->output, GZIP_OUTPUT_SIZE);
+        result = decode(*cursor, buffer.get(), n) == n;
+    }
+
+    while (result && size > 0) {
+        size_t n = std::min<uint64_t>(size, GZIP_OUTPUT_SIZE);
+        result = decode(*cursor, buffer.get(), n) == n && consumer({buffer.get(), n});
+        size -= n;
+    }
+
+    inflateEnd(cursor->stream.get());
+    return result;
+}
+
+std::optional<go::symbol::GzipStream::Cursor> go::symbol::GzipStream::restore(uint64_t offset) const {
+    if (mCheckpoints.empty())
+        return std::nullopt;
+
+    size_t index = std::min<size_t>(offset / GZIP_CHECKPOINT_INTERVAL, mCheckpoints.size() - 1);
+
+    Cursor cursor = {
+            std::make_unique<z_stream>(),
+            std::make_unique<std::byte[]>(GZIP_INPUT_SIZE),
+            mCheckpoints[index].input,
+            index * GZIP_CHECKPOINT_INTERVAL,
+            false
+    };
+
+    if (inflateCopy(cursor.stream.get(), mCheckpoints[index].stream.get()) != Z_OK)
+        return std::nullopt;
+
+    cursor.stream->next_in = nullptr;
+    cursor.stream->avail_in = 0;
+
+    return cursor;
+}
+
+size_t go::symbol::GzipStream::decode(Cursor &cursor, std::byte *buffer, size_t length) const {
+    z_stream *stream = cursor.stream.get();
+    size_t total = 0;
+
+    auto fill = [&]() {
+        while (true) {
+            ssize_t n = pread(mFD, cursor.buffer.get(), GZIP_INPUT_SIZE, (off_t) cursor.input);
+
+            if (n < 0 && errno == EINTR)
+                continue;
+
+            if (n <= 0)
+                return false;
+
+            stream->next_in = (Bytef *) cursor.buffer.get();
+            stream->avail_in = (uInt) n;
+            cursor.input += n;
+
+            return true;
+        }
+    };
+
+    while (!cursor.end && total < length) {
+        if (stream->avail_in == 0 && !fill()) {
+            LOG_ERROR("unexpected end of gzip stream");
+            cursor.end = true;
+            break;
+        }
+
+        stream->next_out = (Bytef *) (buffer + total);
+        stream->avail_out = (uInt) (length - total);
+
+        int status = inflate(stream, Z_NO_FLUSH);
+        size_t produced = length - total - stream->avail_out;
+
+        cursor.output += produced;
+        total += produced;
+
+        if (status == Z_STREAM_END) {
+            if ((stream->avail_in == 0 && !fill()) || std::byte(*stream->next_in) != GZIP_MAGIC) {
+                cursor.end = true;
+                break;
+            }
+
+            inflateReset(stream);
+            continue;
+        }
+
+        if (status != Z_OK && status != Z_BUF_ERROR) {
+            LOG_ERROR("gzip decompress failed: %d", status);
+            cursor.end = true;
+            break;
+        }
+    }
+
+    return total;
+}
@@ -0,0 +1,128 @@
+#ifndef GO_SYMBOL_COMPRESSION_H
+#define GO_SYMBOL_COMPRESSION_H
+
+#include <go/symbol/symbol.h>
+#include <zlib.h>
+#include <zstd.h>
+#include <list>
+#include <functional>
+
+namespace go::symbol {
+    enum CompressionType {
+        ZlibCompression = 1,
+        ZstdCompression = 2
+    };
+
+    struct CompressedData {
+        CompressionType type;
+        uint64_t size;
+        std::span<const std::byte> payload;
+    };
+
+    std::optional<CompressedData>
+    compressedData(const std::shared_ptr<elf::ISection> &section, endian::Converter converter, size_t ptrSize);
+
+    bool decompress(const CompressedData &data, std::span<std::byte> out);
+
+    class CompressedSection {
+    public:
+        CompressedSection(std::shared_ptr<elf::ISection> section, CompressedData data);
+        CompressedSection(const CompressedSection &) = delete;
+        ~CompressedSection();
+
+    public:
+        CompressedSection &operator=(const CompressedSection &) = delete;
+
+    public:
+        [[nodiscard]] uint64_t size() const;
+        [[nodiscard]] memory::Usage memoryUsage() const;
+
+    public:
+        void seek(uint64_t offset);
+        size_t read(void *buffer, size_t length);
+        std::string readString();
+
+    private:
+        struct Chunk {
+            uint64_t index;
+            size_t size;
+            std::unique_ptr<std::byte[]> data;
+        };
+
+        struct FrameCheckpoint {
+            uint64_t output;
+            size_t input;
+        };
+
+    private:
+        std::span<const std::byte> view();
+        const Chunk *chunk(uint64_t index);
+
+    private:
+        bool restore(uint64_t offset);
+        size_t decode(std::byte *buffer, size_t length);
+
+    private:
+        uint64_t mPosition;
+        uint64_t mDecoded;
+        bool mValid;
+        CompressedData mData;
+        std::shared_ptr<elf::ISection> mSection;
+        std::list<Chunk> mChunks;
+        std::optional<memory::Buffer> mBuffer;
+
+    private:
+        z_stream mInflate{};
+        std::vector<std::unique_ptr<z_stream>> mCheckpoints;
+
+    private:
+        ZSTD_DStream *mZstd{};
+        size_t mInput{};
+        std::vector<FrameCheckpoint> mFrames;
+    };
+
+    class GzipStream {
+    public:
+        explicit GzipStream(int fd);
+        GzipStream(const GzipStream &) = delete;
+        ~GzipStream();
+
+    public:
+        GzipStream &operator=(const GzipStream &) = delete;
+
+    public:
+        [[nodiscard]] bool valid() const;
+        [[nodiscard]] uint64_t position() const;
+
+    public:
+        bool read(void *buffer, size_t length);
+        bool skip(uint64_t length);
+        bool copy(uint64_t offset, uint64_t size, const std::function<bool(std::span<const std::byte>)> &consumer) const;
+
+    private:
+        struct Cursor {
+            std::unique_ptr<z_stream> stream;
+            std::unique_ptr<std::byte[]> buffer;
+            uint64_t input;
+            uint64_t output;
+            bool end;
+        };
+
+        struct Checkpoint {
+            uint64_t input;
+            std::unique_ptr<z_stream> stream;
+        };
+
+    private:
+        [[nodiscard]] std::optional<Cursor> restore(uint64_t offset) const;
+        size_t decode(Cursor &cursor, std::byte *buffer, size_t length) const;
+
+    private:
+        int mFD;
+        bool mValid;
+        Cursor mCursor;
+        std::vector<Checkpoint> mCheckpoints;
+    };
+}
+
+#endif //GO_SYMBOL_COMPRESSION_H
@@ -0,0 +1,223 @@
+#include <go/symbol/exporter.h>
+#include <mutex>
+#include <thread>
+#include <charconv>
+#include <condition_variable>
+#include <zero/log.h>
+
+constexpr auto CHUNK_FUNCTIONS = 2048;
+constexpr auto CHUNK_WINDOW_FACTOR = 2;
+constexpr auto BPF_PAGE_SIZE = 4096;
+
+static void append(std::string &output, uint64_t value, int base = 16) {
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, base);
+    output.append(buffer, result.ptr);
+}
+
+go::symbol::Exporter::Exporter(const SymbolTable *table, size_t threads)
+        : mTable(table), mThreads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {
+
+}
+
+bool go::symbol::Exporter::perfMap(std::ostream &stream) const {
+    return write(stream, [this](std::string &output, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            SymbolEntry entry = mTable->operator[](i);
+            uint64_t size = mTable->operator[](i + 1).entry() - entry.entry();
+
+            if (!size)
+                continue;
+
+            append(output, entry.entry());
+            output += ' ';
+            append(output, size);
+            output += ' ';
+            output += entry.symbol().name();
+            output += '\n';
+        }
+    });
+}
+
+bool go::symbol::Exporter::breakpad(std::ostream &stream, const BreakpadModule &module) const {
+    std::string header = "MODULE " + module.os + " " + module.arch + " " + module.id + " " + module.name + "\n";
+    bool lines = (mTable->mCapabilities & FileCapability) && mTable->mFileTable;
+
+    for (const auto &[key, name]: mTable->files()) {
+        header += "FILE ";
+        append(header, key, 10);
+        header += ' ';
+        header += name;
+        header += '\n';
+    }
+
+    stream.write(header.data(), (std::streamsize) header.size());
+
+    return write(stream, [=, this](std::string &output, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            SymbolEntry entry = mTable->operator[](i);
+            uint64_t next = mTable->operator[](i + 1).entry();
+
+            if (next == entry.entry())
+                continue;
+
+            Symbol symbol = entry.symbol();
+
+            output += "FUNC ";
+            append(output, entry.entry() - module.base);
+            output += ' ';
+            append(output, next - entry.entry());
+            output += " 0 ";
+            output += symbol.name();
+            output += '\n';
+
+            if (!lines)
+                continue;
+
+            symbol.lines([&](uint64_t start, uint64_t end, std::optional<uint32_t> file, int line) {
+                end = std::min(end, next);
+
+                if (start >= end)
+                    return;
+
+                append(output, start - module.base);
+                output += ' ';
+                append(output, end - start);
+                output += ' ';
+                append(output, line, 10);
+                output += ' ';
+                append(output, *file, 10);
+                output += '\n';
+            });
+        }
+    });
+}
+
+bool go::symbol::Exporter::bpf(std::ostream &ranges, std::ostream &names) const {
+    size_t size = mTable->size();
+
+    if (!size)
+        return false;
+
+    uint64_t base = mTable->operator[](0).entry();
+    uint64_t end = mTable->operator[](size).entry();
+
+    if (end - base >= UINT32_MAX) {
+        LOG_ERROR("text size exceeds bpf range limit");
+        return false;
+    }
+
+    std::vector<BPFRange> table;
+    std::vector<uint32_t> offsets;
+    std::string strings;
+
+    for (size_t i = 0; i < size; i++) {
+        SymbolEntry entry = mTable->operator[](i);
+
+        if (mTable->operator[](i + 1).entry() == entry.entry())
+            continue;
+
+        table.push_back({uint32_t(entry.entry() - base), uint32_t(offsets.size())});
+        offsets.push_back(strings.size());
+        strings += entry.symbol().name();
+        strings += '\0';
+    }
+
+    table.push_back({uint32_t(end - base), UINT32_MAX});
+
+    BPFRangeHeader header = {
+            BPF_RANGE_MAGIC,
+            BPF_RANGE_VERSION,
+            sizeof(BPFRangeHeader),
+            uint32_t(table.size()),
+            base,
+            end
+    };
+
+    size_t length = sizeof(BPFRangeHeader) + table.size() * sizeof(BPFRange);
+    table.resize(table.size() + (BPF_PAGE_SIZE - length % BPF_PAGE_SIZE) % BPF_PAGE_SIZE / sizeof(BPFRange), {UINT32_MAX, UINT32_MAX});
+
+    ranges.write((const char *) &header, sizeof(BPFRangeHeader));
+    ranges.write((const char *) table.data(), (std::streamsize) (table.size() * sizeof(BPFRange)));
+
+    auto count = uint32_t(offsets.size());
+
+    names.write((const char *) &count, sizeof(uint32_t));
+    names.write((const char *) offsets.data(), (std::streamsize) (offsets.size() * sizeof(uint32_t)));
+    names.write(strings.data(), (std::streamsize) strings.size());
+
+    return ranges.good() && names.good();
+}
+
+bool go::symbol::Exporter::write(
+        std::ostream &stream,
+        const std::function<void(std::string &, size_t, size_t)> &generate
+) const {
+    size_t size = mTable->size();
+    size_t count = (size + CHUNK_FUNCTIONS - 1) / CHUNK_FUNCTIONS;
+    size_t window = CHUNK_WINDOW_FACTOR * mThreads;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t next = 0;
+    size_t written = 0;
+    std::vector<std::optional<std::string>> chunks(count);
+
+    auto worker = [&]() {
+        while (true) {
+            size_t index;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+
+                cv.wait(lock, [&]() {
+                    return next >= count || next < written + window;
+                });
+
+                if (next >= count)
+                    break;
+
+                index = next++;
+            }
+
+            std::string output;
+            generate(output, index * CHUNK_FUNCTIONS, std::min(size, (index + 1) * CHUNK_FUNCTIONS));
+
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                chunks[index] = std::move(output);
+            }
+
+            cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < std::min(mThreads, count); i++)
+        threads.emplace_back(worker);
+
+    for (size_t i = 0; i < count; i++) {
+        std::string output;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            cv.wait(lock, [&]() {
+                return chunks[i].has_value();
+            });
+
+            output = std::move(*chunks[i]);
+            chunks[i].reset();
+            written = i + 1;
+        }
+
+        cv.notify_all();
+        stream.write(output.data(), (std::streamsize) output.size());
+    }
+
+    for (auto &thread: threads)
+        thread.join();
+
+    return stream.good();
+}
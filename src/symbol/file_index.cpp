@@ -0,0 +1,155 @@
+#include <go/symbol/file_index.h>
+#include <algorithm>
+
+go::symbol::FileIndex::FileIndex(const SymbolTable *table, StringPool *pool) : mPool(pool) {
+    for (auto [key, name]: table->files()) {
+        auto it = mIDs.find(name);
+
+        if (it == mIDs.end()) {
+            if (mPool) {
+                uint32_t pooled = mPool->acquire(name);
+
+                name = mPool->string(pooled);
+                mPoolIDs.push_back(pooled);
+            }
+
+            it = mIDs.emplace(name, uint32_t(mNames.size())).first;
+            mNames.push_back(name);
+        }
+
+        mKeys.emplace(key, it->second);
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> references;
+
+    if (!mNames.empty()) {
+        std::vector<uint32_t> ids;
+        uint32_t index = 0;
+
+        for (const auto &entry: *table) {
+            Symbol symbol = entry.symbol();
+            PCValue files = symbol.pcValue(PCFileTable);
+
+            ids.clear();
+
+            while (files.next()) {
+                std::optional<uint32_t> key = symbol.fileKey(files.value());
+
+                if (!key)
+                    continue;
+
+                std::optional<uint32_t> file = id(*key);
+
+                if (file && std::find(ids.begin(), ids.end(), *file) == ids.end())
+                    ids.push_back(*file);
+            }
+
+            for (const auto &file: ids)
+                references.emplace_back(file, index);
+
+            index++;
+        }
+    }
+
+    std::sort(references.begin(), references.end());
+
+    mOffsets.resize(mNames.size() + 1);
+    mFunctions.reserve(references.size());
+
+    for (const auto &[file, function]: references) {
+        mOffsets[file + 1]++;
+        mFunctions.push_back(function);
+    }
+
+    for (size_t i = 0; i < mNames.size(); i++)
+        mOffsets[i + 1] += mOffsets[i];
+}
+
+go::symbol::FileIndex::~FileIndex() {
+    for (const auto &id: mPoolIDs)
+        mPool->release(id);
+}
+
+size_t go::symbol::FileIndex::size() const {
+    return mNames.size();
+}
+
+go::memory::Usage go::symbol::FileIndex::memoryUsage() const {
+    size_t heap = (mPoolIDs.capacity() + mOffsets.capacity() + mFunctions.capacity()) * sizeof(uint32_t);
+
+    heap += mNames.capacity() * sizeof(std::string_view);
+    heap += (mKeys.bucket_count() + mIDs.bucket_count()) * sizeof(void *);
+    heap += mKeys.size() * (sizeof(std::pair<uint32_t, uint32_t>) + 2 * sizeof(void *));
+    heap += mIDs.size() * (sizeof(std::pair<std::string_view, uint32_t>) + 2 * sizeof(void *));
+
+    return {heap, 0, 0};
+}
+
+std::string_view go::symbol::FileIndex::name(uint32_t id) const {
+    return mNames[id];
+}
+
+std::optional<uint32_t> go::symbol::FileIndex::poolID(uint32_t id) const {
+    if (!mPool)
+        return std::nullopt;
+
+    return mPoolIDs[id];
+}
+
+std::optional<uint32_t> go::symbol::FileIndex::find(std::string_view name) const {
+    auto it = mIDs.find(name);
+
+    if (it == mIDs.end())
+        return std::nullopt;
+
+    return it->second;
+}
+
+std::vector<uint32_t> go::symbol::FileIndex::match(std::string_view name) const {
+    std::optional<uint32_t> exact = find(name);
+
+    if (exact)
+        return {*exact};
+
+    std::vector<uint32_t> ids;
+
+    for (uint32_t i = 0; i < mNames.size(); i++) {
+        std::string_view path = mNames[i];
+
+        if (path.ends_with(name) && path.size() > name.size() && path[path.size() - name.size() - 1] == '/')
+            ids.push_back(i);
+    }
+
+    return ids;
+}
+
+std::optional<uint32_t> go::symbol::FileIndex::id(uint32_t key) const {
+    auto it = mKeys.find(key);
+
+    if (it == mKeys.end())
+        return std::nullopt;
+
+    return it->second;
+}
+
+std::optional<uint32_t> go::symbol::FileIndex::sourceFile(const Symbol &symbol, uint64_t pc) const {
+    PCValue files = symbol.pcValue(PCFileTable);
+
+    while (files.next()) {
+        if (pc >= files.end())
+            continue;
+
+        std::optional<uint32_t> key = symbol.fileKey(files.value());
+
+        if (!key)
+            return std::nullopt;
+
+        return id(*key);
+    }
+
+    return std::nullopt;
+}
+
+std::span<const uint32_t> go::symbol::FileIndex::functions(uint32_t id) const {
+    return {mFunctions.data() + mOffsets[id], mFunctions.data() + mOffsets[id + 1]};
+}
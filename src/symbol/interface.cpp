@@ -11,11 +11,28 @@ go::symbol::InterfaceTable::InterfaceTable(
         endian::Converter converter
 ) : mReader(std::move(reader)), mSection(std::move(section)), mVersion(version), mTypes(types), mBase(base),
     mPtrSize(ptrSize), mConverter(converter) {
+    mLinks = {mSection->data(), mSection->size()};
+}
+
+go::symbol::InterfaceTable::InterfaceTable(
+        elf::Reader reader,
+        std::span<const std::byte> links,
+        Version version,
+        uint64_t types,
+        uint64_t base,
+        size_t ptrSize,
+        endian::Converter converter
+) : mReader(std::move(reader)), mLinks(links), mVersion(version), mTypes(types), mBase(base), mPtrSize(ptrSize),
+    mConverter(converter) {
 
 }
 
 size_t go::symbol::InterfaceTable::size() const {
-    return mSection->size() / mPtrSize;
+    return mLinks.size() / mPtrSize;
+}
+
+go::memory::Usage go::symbol::InterfaceTable::memoryUsage() const {
+    return {0, mLinks.size(), memory::resident(mLinks).value_or(0)};
 }
 
 go::symbol::Interface go::symbol::InterfaceTable::operator[](size_t index) const {
@@ -23,7 +40,7 @@ go::symbol::Interface go::symbol::InterfaceTable::operator[](size_t index) const
 }
 
 go::symbol::InterfaceIterator go::symbol::InterfaceTable::begin() const {
-    return {this, mSection->data()};
+    return {this, mLinks.data()};
 }
 
 go::symbol::InterfaceIterator go::symbol::InterfaceTable::end() const {
@@ -0,0 +1,520 @@
+#include <go/symbol/layer.h>
+#include "compression.h"
+#include <zero/log.h>
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+constexpr auto TAR_BLOCK_SIZE = 512;
+constexpr auto TAR_NAME_OFFSET = 0;
+constexpr auto TAR_NAME_SIZE = 100;
+constexpr auto TAR_SIZE_OFFSET = 124;
+constexpr auto TAR_SIZE_SIZE = 12;
+constexpr auto TAR_CHECKSUM_OFFSET = 148;
+constexpr auto TAR_CHECKSUM_SIZE = 8;
+constexpr auto TAR_TYPE_OFFSET = 156;
+constexpr auto TAR_LINK_OFFSET = 157;
+constexpr auto TAR_LINK_SIZE = 100;
+constexpr auto TAR_MAGIC_OFFSET = 257;
+constexpr auto TAR_PREFIX_OFFSET = 345;
+constexpr auto TAR_PREFIX_SIZE = 155;
+
+constexpr auto USTAR_MAGIC = "ustar";
+constexpr auto USTAR_MAGIC_SIZE = 5;
+
+constexpr auto GZIP_MAGIC = "\x1f\x8b";
+constexpr auto GZIP_MAGIC_SIZE = 2;
+
+constexpr auto WHITEOUT_PREFIX = ".wh.";
+
+constexpr auto COPY_BUFFER_SIZE = 64 * 1024;
+constexpr auto MAX_LINK_DEPTH = 8;
+
+namespace {
+    struct PaxHeader {
+        std::optional<std::string> path;
+        std::optional<std::string> link;
+        std::optional<uint64_t> size;
+    };
+
+    std::string_view field(const std::byte *header, size_t offset, size_t size) {
+        const auto *data = reinterpret_cast<const char *>(header + offset);
+        return {data, strnlen(data, size)};
+    }
+
+    std::optional<uint64_t> number(const std::byte *header, size_t offset, size_t size) {
+        const auto *data = reinterpret_cast<const unsigned char *>(header + offset);
+
+        if (data[0] & 0x80) {
+            if (data[0] & 0x40)
+                return std::nullopt;
+
+            uint64_t value = data[0] & 0x3f;
+
+            for (size_t i = 1; i < size; i++) {
+                if (value >> 56)
+                    return std::nullopt;
+
+                value = (value << 8) | data[i];
+            }
+
+            return value;
+        }
+
+        uint64_t value = 0;
+        size_t i = 0;
+
+        while (i < size && (data[i] == ' ' || data[i] == '\0'))
+            i++;
+
+        for (; i < size && data[i] >= '0' && data[i] <= '7'; i++)
+            value = (value << 3) | (data[i] - '0');
+
+        if (i < size && data[i] != ' ' && data[i] != '\0')
+            return std::nullopt;
+
+        return value;
+    }
+
+    bool verify(const std::byte *header) {
+        std::optional<uint64_t> checksum = number(header, TAR_CHECKSUM_OFFSET, TAR_CHECKSUM_SIZE);
+
+        if (!checksum)
+            return false;
+
+        uint64_t sum = 0;
+
+        for (size_t i = 0; i < TAR_BLOCK_SIZE; i++) {
+            if (i >= TAR_CHECKSUM_OFFSET && i < TAR_CHECKSUM_OFFSET + TAR_CHECKSUM_SIZE) {
+                sum += ' ';
+                continue;
+            }
+
+            sum += std::to_integer<uint8_t>(header[i]);
+        }
+
+        return sum == *checksum;
+    }
+
+    std::string normalize(std::string_view name) {
+        std::string path = std::filesystem::path(name).lexically_normal().string();
+
+        while (path.starts_with("./"))
+            path.erase(0, 2);
+
+        while (path.starts_with('/'))
+            path.erase(0, 1);
+
+        if (path.ends_with('/'))
+            path.pop_back();
+
+        return path == "." ? "" : path;
+    }
+
+    bool whiteout(const std::string &path) {
+        return std::filesystem::path(path).filename().string().starts_with(WHITEOUT_PREFIX);
+    }
+
+    std::optional<PaxHeader> parsePax(std::string_view records) {
+        PaxHeader header;
+
+        while (!records.empty()) {
+            size_t space = records.find(' ');
+
+            if (space == std::string_view::npos)
+                break;
+
+            size_t length = 0;
+
+            for (size_t i = 0; i < space; i++) {
+                if (records[i] < '0' || records[i] > '9')
+                    return std::nullopt;
+
+                length = length * 10 + (records[i] - '0');
+            }
+
+            if (length <= space + 1 || length > records.size())
+                break;
+
+            std::string_view record = records.substr(space + 1, length - space - 2);
+            size_t equal = record.find('=');
+
+            if (equal != std::string_view::npos) {
+                std::string_view key = record.substr(0, equal);
+                std::string_view value = record.substr(equal + 1);
+
+                if (key == "path") {
+                    header.path = std::string(value);
+                } else if (key == "linkpath") {
+                    header.link = std::string(value);
+                } else if (key == "size") {
+                    if (value.empty())
+                        return std::nullopt;
+
+                    uint64_t size = 0;
+
+                    for (char c: value) {
+                        if (c < '0' || c > '9' || size > (UINT64_MAX - (c - '0')) / 10)
+                            return std::nullopt;
+
+                        size = size * 10 + (c - '0');
+                    }
+
+                    header.size = size;
+                }
+            }
+
+            records.remove_prefix(length);
+        }
+
+        return header;
+    }
+
+    class Archive {
+    public:
+        Archive(int fd, std::shared_ptr<go::symbol::GzipStream> stream) : mFD(fd), mPosition(0), mStream(std::move(stream)) {
+
+        }
+
+    public:
+        [[nodiscard]] uint64_t position() const {
+            return mStream ? mStream->position() : mPosition;
+        }
+
+    public:
+        bool read(void *buffer, size_t length) {
+            if (mStream)
+                return mStream->read(buffer, length);
+
+            auto *ptr = static_cast<std::byte *>(buffer);
+
+            while (length > 0) {
+                ssize_t n = pread(mFD, ptr, length, (off_t) mPosition);
+
+                if (n < 0) {
+                    if (errno == EINTR)
+                        continue;
+
+                    return false;
+                }
+
+                if (n == 0)
+                    return false;
+
+                ptr += n;
+                length -= n;
+                mPosition += n;
+            }
+
+            return true;
+        }
+
+        bool skip(uint64_t length) {
+            if (mStream)
+                return mStream->skip(length);
+
+            mPosition += length;
+            return true;
+        }
+
+        std::optional<std::string> payload(uint64_t size) {
+            std::string payload(size, '\0');
+
+            if (!read(payload.data(), size))
+                return std::nullopt;
+
+            if (size % TAR_BLOCK_SIZE && !skip(TAR_BLOCK_SIZE - size % TAR_BLOCK_SIZE))
+                return std::nullopt;
+
+            while (!payload.empty() && payload.back() == '\0')
+                payload.pop_back();
+
+            return payload;
+        }
+
+    private:
+        int mFD;
+        uint64_t mPosition;
+        std::shared_ptr<go::symbol::GzipStream> mStream;
+    };
+
+    bool writeFully(int fd, const std::byte *buffer, size_t length) {
+        while (length > 0) {
+            ssize_t n = write(fd, buffer, length);
+
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+
+                return false;
+            }
+
+            buffer += n;
+            length -= n;
+        }
+
+        return true;
+    }
+
+    bool copyRange(int in, int out, uint64_t offset, uint64_t size) {
+        auto position = (off_t) offset;
+        std::unique_ptr<std::byte[]> buffer = std::make_unique<std::byte[]>(COPY_BUFFER_SIZE);
+
+        while (size > 0) {
+            ssize_t n = pread(in, buffer.get(), std::min<uint64_t>(size, COPY_BUFFER_SIZE), position);
+
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+
+                return false;
+            }
+
+            if (n == 0 || !writeFully(out, buffer.get(), n))
+                return false;
+
+            position += n;
+            size -= n;
+        }
+
+        return true;
+    }
+}
+
+go::symbol::Layer::Layer(std::filesystem::path path, std::shared_ptr<GzipStream> stream, std::vector<LayerEntry> entries)
+        : mPath(std::move(path)), mStream(std::move(stream)), mEntries(std::move(entries)) {
+    for (size_t i = 0; i < mEntries.size(); i++)
+        mIndex[mEntries[i].name] = i;
+}
+
+bool go::symbol::Layer::compressed() const {
+    return mStream != nullptr;
+}
+
+std::span<const go::symbol::LayerEntry> go::symbol::Layer::entries() const {
+    return mEntries;
+}
+
+const go::symbol::LayerEntry *go::symbol::Layer::find(std::string_view name) const {
+    auto it = mIndex.find(normalize(name));
+
+    if (it == mIndex.end())
+        return nullptr;
+
+    return &mEntries[it->second];
+}
+
+const go::symbol::LayerEntry *go::symbol::Layer::resolve(std::string_view name) const {
+    const LayerEntry *entry = find(name);
+
+    for (int i = 0; entry && i < MAX_LINK_DEPTH; i++) {
+        if (entry->type == RegularEntry)
+            return entry;
+
+        if (entry->type == HardLinkEntry || entry->link.starts_with('/')) {
+            entry = find(entry->link);
+            continue;
+        }
+
+        entry = find((std::filesystem::path(entry->name).parent_path() / entry->link).string());
+    }
+
+    if (entry && entry->type == RegularEntry)
+        return entry;
+
+    return nullptr;
+}
+
+std::optional<go::symbol::Reader> go::symbol::Layer::open(std::string_view name) const {
+    const LayerEntry *entry = resolve(name);
+
+    if (!entry) {
+        LOG_ERROR("layer entry %.*s not found", (int) name.size(), name.data());
+        return std::nullopt;
+    }
+
+    int fd = memfd_create(entry->name.c_str(), MFD_CLOEXEC);
+
+    if (fd < 0) {
+        LOG_ERROR("create memory file failed: %s", strerror(errno));
+        return std::nullopt;
+    }
+
+    std::shared_ptr<void> handle(nullptr, [=](void *) {
+        close(fd);
+    });
+
+    if (mStream) {
+        bool copied = mStream->copy(entry->offset, entry->size, [=](std::span<const std::byte> data) {
+            return writeFully(fd, data.data(), data.size());
+        });
+
+        if (!copied) {
+            LOG_ERROR("decompress layer entry %s failed", entry->name.c_str());
+            return std::nullopt;
+        }
+    } else {
+        int in = ::open(mPath.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (in < 0) {
+            LOG_ERROR("open %s failed: %s", mPath.string().c_str(), strerror(errno));
+            return std::nullopt;
+        }
+
+        bool copied = copyRange(in, fd, entry->offset, entry->size);
+        close(in);
+
+        if (!copied) {
+            LOG_ERROR("copy layer entry %s failed", entry->name.c_str());
+            return std::nullopt;
+        }
+    }
+
+    std::filesystem::path path = std::filesystem::path("/proc/self/fd") / std::to_string(fd);
+    auto readerResult = elf::openFile(path);
+
+    if (!readerResult) {
+        LOG_ERROR("open elf file failed");
+        return std::nullopt;
+    }
+
+    return Reader(*readerResult, path, std::move(handle));
+}
+
+std::optional<go::symbol::Layer> go::symbol::openLayer(const std::filesystem::path &path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+        LOG_ERROR("open %s failed: %s", path.string().c_str(), strerror(errno));
+        return std::nullopt;
+    }
+
+    char magic[GZIP_MAGIC_SIZE] = {};
+    std::shared_ptr<GzipStream> stream;
+
+    if (pread(fd, magic, GZIP_MAGIC_SIZE, 0) == GZIP_MAGIC_SIZE && memcmp(magic, GZIP_MAGIC, GZIP_MAGIC_SIZE) == 0) {
+        stream = std::make_shared<GzipStream>(fd);
+
+        if (!stream->valid()) {
+            LOG_ERROR("init gzip stream failed");
+            return std::nullopt;
+        }
+    }
+
+    std::shared_ptr<void> handle;
+
+    if (!stream)
+        handle = std::shared_ptr<void>(nullptr, [=](void *) {
+            close(fd);
+        });
+
+    Archive archive(fd, stream);
+    std::vector<go::symbol::LayerEntry> entries;
+
+    PaxHeader pax;
+    std::optional<std::string> longName;
+    std::optional<std::string> longLink;
+
+    std::byte header[TAR_BLOCK_SIZE];
+
+    while (true) {
+        if (!archive.read(header, TAR_BLOCK_SIZE)) {
+            LOG_ERROR("unexpected end of layer");
+            return std::nullopt;
+        }
+
+        if (std::all_of(header, header + TAR_BLOCK_SIZE, [](std::byte b) { return b == std::byte{0}; }))
+            break;
+
+        if (!verify(header)) {
+            LOG_ERROR("invalid tar header checksum");
+            return std::nullopt;
+        }
+
+        std::optional<uint64_t> size = number(header, TAR_SIZE_OFFSET, TAR_SIZE_SIZE);
+
+        if (!size) {
+            LOG_ERROR("invalid tar entry size");
+            return std::nullopt;
+        }
+
+        if (pax.size)
+            size = *pax.size;
+
+        auto type = std::to_integer<char>(header[TAR_TYPE_OFFSET]);
+
+        if (type == 'x' || type == 'L' || type == 'K') {
+            std::optional<std::string> payload = archive.payload(*size);
+
+            if (!payload) {
+                LOG_ERROR("read tar extended header failed");
+                return std::nullopt;
+            }
+
+            if (type == 'x') {
+                std::optional<PaxHeader> result = parsePax(*payload);
+
+                if (!result) {
+                    LOG_ERROR("invalid pax header");
+                    return std::nullopt;
+                }
+
+                pax = std::move(*result);
+            } else if (type == 'L') {
+                longName = std::move(*payload);
+            } else {
+                longLink = std::move(*payload);
+            }
+
+            continue;
+        }
+
+        std::string name;
+
+        if (pax.path) {
+            name = *pax.path;
+        } else if (longName) {
+            name = *longName;
+        } else {
+            name = field(header, TAR_NAME_OFFSET, TAR_NAME_SIZE);
+
+            if (memcmp(header + TAR_MAGIC_OFFSET, USTAR_MAGIC, USTAR_MAGIC_SIZE) == 0) {
+                std::string_view prefix = field(header, TAR_PREFIX_OFFSET, TAR_PREFIX_SIZE);
+
+                if (!prefix.empty())
+                    name = std::string(prefix) + "/" + name;
+            }
+        }
+
+        std::string link = pax.link ? *pax.link : longLink ? *longLink : std::string(
+                field(header, TAR_LINK_OFFSET, TAR_LINK_SIZE)
+        );
+
+        pax = {};
+        longName.reset();
+        longLink.reset();
+
+        uint64_t offset = archive.position();
+        std::string normalized = normalize(name);
+
+        if (!whiteout(normalized)) {
+            if (type == '0' || type == '\0' || type == '7')
+                entries.push_back({std::move(normalized), {}, RegularEntry, offset, *size});
+            else if (type == '1')
+                entries.push_back({std::move(normalized), normalize(link), HardLinkEntry, offset, 0});
+            else if (type == '2')
+                entries.push_back({std::move(normalized), link, SymbolicLinkEntry, offset, 0});
+        }
+
+        uint64_t padded = (*size + TAR_BLOCK_SIZE - 1) / TAR_BLOCK_SIZE * TAR_BLOCK_SIZE;
+
+        if (padded && !archive.skip(padded)) {
+            LOG_ERROR("skip tar entry %s failed", name.c_str());
+            return std::nullopt;
+        }
+    }
+
+    return Layer(path, std::move(stream), std::move(entries));
+}
@@ -0,0 +1,57 @@
+#include <go/symbol/line_index.h>
+
+go::symbol::LineIndex::LineIndex(const SymbolTable *table, const FileIndex *files) : mTable(table), mFiles(files) {
+
+}
+
+std::span<const go::symbol::PCRange> go::symbol::LineIndex::find(uint32_t file, int line) {
+    if (file >= mFiles->size())
+        return {};
+
+    auto it = mLines.find(file);
+
+    if (it == mLines.end()) {
+        build(file);
+        it = mLines.find(file);
+    }
+
+    auto lineIterator = it->second.find(line);
+
+    if (lineIterator == it->second.end())
+        return {};
+
+    return lineIterator->second;
+}
+
+std::vector<go::symbol::PCRange> go::symbol::LineIndex::find(std::string_view file, int line) {
+    std::vector<PCRange> ranges;
+
+    for (const auto &id: mFiles->match(file)) {
+        std::span<const PCRange> result = find(id, line);
+        ranges.insert(ranges.end(), result.begin(), result.end());
+    }
+
+    return ranges;
+}
+
+void go::symbol::LineIndex::build(uint32_t file) {
+    std::unordered_map<int, std::vector<PCRange>> &lines = mLines[file];
+
+    for (const auto &function: mFiles->functions(file)) {
+        Symbol symbol = mTable->operator[](function).symbol();
+
+        symbol.lines([&](uint64_t start, uint64_t end, std::optional<uint32_t> key, int line) {
+            if (!key || mFiles->id(*key) != file)
+                return;
+
+            std::vector<PCRange> &ranges = lines[line];
+
+            if (!ranges.empty() && ranges.back().end == start) {
+                ranges.back().end = end;
+                return;
+            }
+
+            ranges.push_back({start, end});
+        });
+    }
+}
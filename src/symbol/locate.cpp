@@ -0,0 +1,345 @@
+#include "locate.h"
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+constexpr auto BUILD_INFO_MAGIC = "\xff Go buildinf:";
+constexpr auto BUILD_INFO_MAGIC_SIZE = 14;
+constexpr auto BUILD_INFO_ALIGN = 16;
+
+constexpr auto SYMBOL_HEADER_SIZE = 8;
+constexpr auto RELA_WORDS = 3;
+
+constexpr auto SYMBOL_MAGIC = {
+        0xfffffffbu,
+        0xfffffffau,
+        0xfffffff0u,
+        0xfffffff1u
+};
+
+constexpr auto SYMBOL_MAGIC_12 = 0xfffffffb;
+constexpr auto SYMBOL_MAGIC_116 = 0xfffffffa;
+constexpr auto SYMBOL_MAGIC_118 = 0xfffffff0;
+
+namespace {
+    struct ModuleLayout {
+        int types;
+        int typelinks;
+        int itablinks;
+    };
+
+    constexpr ModuleLayout MODULE_LAYOUT_116 = {35, 40, 43};
+    constexpr ModuleLayout MODULE_LAYOUT_118 = {35, 42, 45};
+    constexpr ModuleLayout MODULE_LAYOUT_120 = {37, 44, 47};
+
+    struct RelativeRelocation {
+        int machine;
+        uint32_t type;
+    };
+
+    constexpr auto RELATIVE_RELOCATIONS = {
+            RelativeRelocation{EM_X86_64, R_X86_64_RELATIVE},
+            RelativeRelocation{EM_AARCH64, R_AARCH64_RELATIVE},
+            RelativeRelocation{EM_PPC64, R_PPC64_RELATIVE},
+            RelativeRelocation{EM_RISCV, R_RISCV_RELATIVE},
+            RelativeRelocation{EM_S390, R_390_RELATIVE}
+    };
+
+    constexpr auto MODULE_FUNC_NAME_TABLE = 1;
+    constexpr auto MODULE_MIN_PC = 20;
+    constexpr auto MODULE_TEXT = 22;
+    constexpr auto MODULE_WORDS = 50;
+
+    bool validate(std::span<const std::byte> data, size_t offset, go::endian::Converter converter) {
+        if (data.size() - offset < SYMBOL_HEADER_SIZE)
+            return false;
+
+        const std::byte *buffer = data.data() + offset;
+        uint32_t magic = converter(buffer, sizeof(uint32_t));
+
+        if (std::find(SYMBOL_MAGIC.begin(), SYMBOL_MAGIC.end(), magic) == SYMBOL_MAGIC.end())
+            return false;
+
+        if (buffer[4] != std::byte{0} || buffer[5] != std::byte{0})
+            return false;
+
+        auto quantum = std::to_integer<uint32_t>(buffer[6]);
+        auto ptrSize = std::to_integer<uint32_t>(buffer[7]);
+
+        if ((quantum != 1 && quantum != 2 && quantum != 4) || (ptrSize != 4 && ptrSize != 8))
+            return false;
+
+        size_t size = data.size() - offset;
+
+        if (size < SYMBOL_HEADER_SIZE + 8 * ptrSize)
+            return false;
+
+        uint64_t funcNum = converter(buffer + 8, ptrSize);
+
+        if (!funcNum)
+            return false;
+
+        if (magic == SYMBOL_MAGIC_12)
+            return SYMBOL_HEADER_SIZE + ptrSize + (2 * funcNum + 1) * ptrSize + sizeof(uint32_t) <= size;
+
+        int first = magic == SYMBOL_MAGIC_116 ? 2 : 3;
+        uint64_t previous = 0;
+
+        for (int i = first; i < first + 5; i++) {
+            uint64_t current = converter(buffer + 8 + i * ptrSize, ptrSize);
+
+            if (current < previous || current >= size)
+                return false;
+
+            previous = current;
+        }
+
+        return true;
+    }
+
+    std::unordered_map<uint64_t, uint64_t>
+    relocations(const elf::Reader &reader, go::endian::Converter converter, size_t ptrSize) {
+        std::unordered_map<uint64_t, uint64_t> relocations;
+
+        if (reader.header()->type() != ET_DYN)
+            return relocations;
+
+        int machine = reader.header()->machine();
+
+        auto it = std::find_if(RELATIVE_RELOCATIONS.begin(), RELATIVE_RELOCATIONS.end(), [=](const auto &relocation) {
+            return relocation.machine == machine;
+        });
+
+        if (it == RELATIVE_RELOCATIONS.end())
+            return relocations;
+
+        std::vector<std::shared_ptr<elf::ISegment>> segments = reader.segments();
+
+        auto dynamic = std::find_if(segments.begin(), segments.end(), [](const auto &segment) {
+            return segment->type() == PT_DYNAMIC;
+        });
+
+        if (dynamic == segments.end())
+            return relocations;
+
+        uint64_t rela = 0;
+        uint64_t size = 0;
+        uint64_t entrySize = RELA_WORDS * ptrSize;
+
+        const std::byte *data = dynamic->operator*().data();
+
+        for (size_t i = 0; i + 2 * ptrSize <= dynamic->operator*().fileSize(); i += 2 * ptrSize) {
+            uint64_t tag = converter(data + i, ptrSize);
+            uint64_t value = converter(data + i + ptrSize, ptrSize);
+
+            if (tag == DT_NULL)
+                break;
+
+            if (tag == DT_RELA)
+                rela = value;
+            else if (tag == DT_RELASZ)
+                size = value;
+            else if (tag == DT_RELAENT)
+                entrySize = value;
+        }
+
+        if (!rela || !size || entrySize < RELA_WORDS * ptrSize)
+            return relocations;
+
+        const std::byte *table = reader.virtualMemory(rela);
+
+        if (!table || !reader.virtualMemory(rela + size - 1))
+            return relocations;
+
+        for (uint64_t offset = 0; offset + entrySize <= size; offset += entrySize) {
+            uint64_t info = converter(table + offset + ptrSize, ptrSize);
+            uint32_t type = ptrSize == 8 ? uint32_t(info) : uint32_t(info & 0xff);
+
+            if (type != it->type)
+                continue;
+
+            relocations.emplace(converter(table + offset, ptrSize), converter(table + offset + 2 * ptrSize, ptrSize));
+        }
+
+        return relocations;
+    }
+
+    bool candidate(const std::byte *buffer, int lead) {
+        return buffer[lead] == std::byte{0xff} &&
+               buffer[lead + 1] == std::byte{0xff} &&
+               buffer[lead + 2] == std::byte{0xff} &&
+               buffer[4] == std::byte{0} &&
+               buffer[5] == std::byte{0};
+    }
+}
+
+const std::byte *go::symbol::SymbolLocation::data() const {
+    return segment->data() + offset;
+}
+
+uint64_t go::symbol::SymbolLocation::address() const {
+    return segment->virtualAddress() + offset;
+}
+
+uint64_t go::symbol::SymbolLocation::fileOffset() const {
+    return segment->offset() + offset;
+}
+
+go::memory::Buffer go::symbol::SymbolLocation::buffer() const {
+    return {
+            (std::byte *) data(),
+            segment->fileSize() - offset,
+            memory::NoHugePage,
+            [segment = segment](std::byte *, size_t) {
+
+            },
+            memory::FileBacking
+    };
+}
+
+std::optional<size_t> go::symbol::findBuildInfo(std::span<const std::byte> data) {
+    for (size_t i = 0; i + BUILD_INFO_ALIGN * 2 <= data.size(); i += BUILD_INFO_ALIGN) {
+        if (memcmp(data.data() + i, BUILD_INFO_MAGIC, BUILD_INFO_MAGIC_SIZE) == 0)
+            return i;
+    }
+
+    return std::nullopt;
+}
+
+std::optional<size_t> go::symbol::findSymbolHeader(std::span<const std::byte> data, endian::Converter converter) {
+    if (data.size() < SYMBOL_HEADER_SIZE)
+        return std::nullopt;
+
+    int lead = converter.endian() == elf::endian::Little ? 1 : 0;
+    size_t i = 0;
+
+#ifdef __SSE2__
+    const __m128i ones = _mm_set1_epi8(-1);
+    const __m128i zeros = _mm_setzero_si128();
+
+    for (; i + 16 + SYMBOL_HEADER_SIZE <= data.size(); i += 16) {
+        const std::byte *ptr = data.data() + i;
+
+        __m128i mask = _mm_and_si128(
+                _mm_and_si128(
+                        _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (ptr + lead)), ones),
+                        _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (ptr + lead + 1)), ones)
+                ),
+                _mm_and_si128(
+                        _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (ptr + lead + 2)), ones),
+                        _mm_and_si128(
+                                _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (ptr + 4)), zeros),
+                                _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (ptr + 5)), zeros)
+                        )
+                )
+        );
+
+        auto bits = (unsigned) _mm_movemask_epi8(mask);
+
+        while (bits) {
+            size_t offset = i + __builtin_ctz(bits);
+
+            if (validate(data, offset, converter))
+                return offset;
+
+            bits &= bits - 1;
+        }
+    }
+#endif
+
+    for (; i + SYMBOL_HEADER_SIZE <= data.size(); i++) {
+        if (candidate(data.data() + i, lead) && validate(data, i, converter))
+            return i;
+    }
+
+    return std::nullopt;
+}
+
+std::optional<go::symbol::ModuleData> go::symbol::findModuleData(
+        const elf::Reader &reader,
+        const std::shared_ptr<elf::ISegment> &segment,
+        const SymbolLocation &location,
+        endian::Converter converter
+) {
+    const std::byte *header = location.data();
+
+    uint32_t magic = converter(header, sizeof(uint32_t));
+    auto ptrSize = std::to_integer<size_t>(header[7]);
+
+    if (magic == SYMBOL_MAGIC_12)
+        return std::nullopt;
+
+    std::vector<ModuleLayout> layouts;
+
+    if (magic == SYMBOL_MAGIC_116)
+        layouts = {MODULE_LAYOUT_116, MODULE_LAYOUT_118, MODULE_LAYOUT_120};
+    else if (magic == SYMBOL_MAGIC_118)
+        layouts = {MODULE_LAYOUT_118, MODULE_LAYOUT_116, MODULE_LAYOUT_120};
+    else
+        layouts = {MODULE_LAYOUT_120, MODULE_LAYOUT_118, MODULE_LAYOUT_116};
+
+    uint64_t address = location.address();
+    uint64_t funcNameTable = address + converter(header + 8 + (magic == SYMBOL_MAGIC_116 ? 2 : 3) * ptrSize, ptrSize);
+
+    std::span<const std::byte> data = {segment->data(), segment->fileSize()};
+    std::unordered_map<uint64_t, uint64_t> relocations = ::relocations(reader, converter, ptrSize);
+
+    for (size_t i = 0; i + MODULE_WORDS * ptrSize <= data.size(); i += ptrSize) {
+        const std::byte *buffer = data.data() + i;
+
+        auto word = [&](int n) -> uint64_t {
+            uint64_t value = converter(buffer + n * ptrSize, ptrSize);
+
+            if (value || relocations.empty())
+                return value;
+
+            auto it = relocations.find(segment->virtualAddress() + i + n * ptrSize);
+
+            if (it == relocations.end())
+                return 0;
+
+            return it->second;
+        };
+
+        if (word(0) != address || word(MODULE_FUNC_NAME_TABLE) != funcNameTable)
+            continue;
+
+        if (word(MODULE_MIN_PC) > word(MODULE_MIN_PC + 1) || word(MODULE_TEXT) > word(MODULE_TEXT + 1))
+            continue;
+
+        for (const auto &layout: layouts) {
+            uint64_t types = word(layout.types);
+            uint64_t etypes = word(layout.types + 1);
+
+            if (!types || types >= etypes)
+                continue;
+
+            uint64_t typelinks = word(layout.typelinks);
+            uint64_t typelinksLength = word(layout.typelinks + 1);
+            uint64_t itablinks = word(layout.itablinks);
+            uint64_t itablinksLength = word(layout.itablinks + 1);
+
+            if (typelinksLength != word(layout.typelinks + 2) || itablinksLength != word(layout.itablinks + 2))
+                continue;
+
+            const std::byte *typelinksBuffer = typelinksLength ? reader.virtualMemory(typelinks) : nullptr;
+            const std::byte *itablinksBuffer = itablinksLength ? reader.virtualMemory(itablinks) : nullptr;
+
+            if ((typelinksLength && !typelinksBuffer) || (itablinksLength && !itablinksBuffer))
+                continue;
+
+            return ModuleData{
+                    types,
+                    etypes,
+                    {typelinksBuffer, typelinksLength * sizeof(int32_t)},
+                    {itablinksBuffer, itablinksLength * ptrSize}
+            };
+        }
+    }
+
+    return std::nullopt;
+}
@@ -0,0 +1,35 @@
+#ifndef GO_SYMBOL_LOCATE_H
+#define GO_SYMBOL_LOCATE_H
+
+#include <go/symbol/symbol.h>
+
+namespace go::symbol {
+    struct SymbolLocation {
+        std::shared_ptr<elf::ISegment> segment;
+        size_t offset;
+
+        [[nodiscard]] const std::byte *data() const;
+        [[nodiscard]] uint64_t address() const;
+        [[nodiscard]] uint64_t fileOffset() const;
+        [[nodiscard]] memory::Buffer buffer() const;
+    };
+
+    struct ModuleData {
+        uint64_t types;
+        uint64_t etypes;
+        std::span<const std::byte> typelinks;
+        std::span<const std::byte> itablinks;
+    };
+
+    std::optional<size_t> findBuildInfo(std::span<const std::byte> data);
+    std::optional<size_t> findSymbolHeader(std::span<const std::byte> data, endian::Converter converter);
+
+    std::optional<ModuleData> findModuleData(
+            const elf::Reader &reader,
+            const std::shared_ptr<elf::ISegment> &segment,
+            const SymbolLocation &location,
+            endian::Converter converter
+    );
+}
+
+#endif //GO_SYMBOL_LOCATE_H
@@ -0,0 +1,230 @@
+#include <go/symbol/name_index.h>
+#include <atomic>
+#include <thread>
+#include <cctype>
+#include <algorithm>
+
+constexpr auto CHUNK_FUNCTIONS = 4096;
+
+constexpr auto CLOSURE_PREFIX = {
+        "func",
+        "gowrap",
+        "deferwrap"
+};
+
+namespace {
+    struct Name {
+        std::string_view function;
+        std::string_view package{};
+        std::string_view receiver{};
+        std::string_view method{};
+        std::string_view generic{};
+    };
+
+    bool isClosure(std::string_view component) {
+        return std::any_of(CLOSURE_PREFIX.begin(), CLOSURE_PREFIX.end(), [=](std::string_view prefix) {
+            return component.starts_with(prefix) &&
+                   component.size() > prefix.size() &&
+                   std::isdigit((unsigned char) component[prefix.size()]);
+        });
+    }
+
+    std::string_view component(std::string_view &str) {
+        int depth = 0;
+
+        for (size_t i = 0; i < str.size(); i++) {
+            if (str[i] == '[' || str[i] == '(')
+                depth++;
+            else if (str[i] == ']' || str[i] == ')')
+                depth--;
+            else if (str[i] == '.' && depth == 0) {
+                std::string_view result = str.substr(0, i);
+                str = str.substr(i + 1);
+                return result;
+            }
+        }
+
+        std::string_view result = str;
+        str = {};
+
+        return result;
+    }
+
+    std::string_view strip(std::string_view str) {
+        return str.substr(0, str.find('['));
+    }
+
+    Name parse(std::string_view function) {
+        Name name = {function};
+
+        std::string_view stripped = function;
+        size_t open = function.find('[');
+
+        if (open != std::string_view::npos) {
+            size_t depth = 0;
+            size_t close = open;
+
+            for (; close < function.size(); close++) {
+                if (function[close] == '[')
+                    depth++;
+                else if (function[close] == ']' && --depth == 0)
+                    break;
+            }
+
+            if (close == function.size())
+                close--;
+
+            name.generic = function.substr(open, close - open + 1);
+            stripped = function.substr(0, open);
+        }
+
+        size_t slash = stripped.rfind('/');
+        size_t dot = stripped.find('.', slash == std::string_view::npos ? 0 : slash);
+
+        if (dot == std::string_view::npos) {
+            name.method = stripped;
+            return name;
+        }
+
+        name.package = function.substr(0, dot);
+
+        std::string_view rest = function.substr(dot + 1);
+        std::string_view first = component(rest);
+        std::string_view second = component(rest);
+
+        if (first.starts_with('(') && first.ends_with(')')) {
+            name.receiver = strip(first.substr(1, first.size() - 2));
+            name.method = strip(second);
+            return name;
+        }
+
+        if (second.empty() || isClosure(second)) {
+            name.method = strip(first);
+            return name;
+        }
+
+        name.receiver = strip(first);
+        name.method = strip(second);
+
+        return name;
+    }
+}
+
+go::symbol::NameIndex::NameIndex(const SymbolTable *table, size_t threads, StringPool *pool) : mPool(pool) {
+    size_t size = table->size();
+    size_t count = (size + CHUNK_FUNCTIONS - 1) / CHUNK_FUNCTIONS;
+
+    std::vector<Name> names(size);
+    std::atomic<size_t> next = 0;
+
+    auto worker = [&]() {
+        while (true) {
+            size_t index = next++;
+
+            if (index >= count)
+                break;
+
+            for (size_t i = index * CHUNK_FUNCTIONS; i < std::min(size, (index + 1) * CHUNK_FUNCTIONS); i++)
+                names[i] = parse(table->operator[](i).symbol().name());
+        }
+    };
+
+    std::vector<std::thread> workers;
+
+    if (!threads)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t i = 0; i < std::min(threads, count); i++)
+        workers.emplace_back(worker);
+
+    for (auto &worker: workers)
+        worker.join();
+
+    for (size_t i = 0; i < NameSpaceCount; i++)
+        intern(NameSpace(i), "");
+
+    mComponents.reserve(size);
+
+    for (const auto &name: names) {
+        mComponents.push_back({
+                intern(FunctionNameSpace, name.function),
+                intern(PackageNameSpace, name.package),
+                intern(ReceiverNameSpace, name.receiver),
+                intern(MethodNameSpace, name.method),
+                intern(GenericNameSpace, name.generic)
+        });
+    }
+}
+
+go::symbol::NameIndex::~NameIndex() {
+    for (const auto &ids: mPoolIDs) {
+        for (const auto &id: ids)
+            mPool->release(id);
+    }
+}
+
+size_t go::symbol::NameIndex::size() const {
+    return mComponents.size();
+}
+
+size_t go::symbol::NameIndex::size(NameSpace space) const {
+    return mStrings[space].size();
+}
+
+go::memory::Usage go::symbol::NameIndex::memoryUsage() const {
+    size_t heap = mComponents.capacity() * sizeof(NameComponents);
+
+    for (size_t i = 0; i < NameSpaceCount; i++) {
+        heap += mStrings[i].capacity() * sizeof(std::string_view);
+        heap += mPoolIDs[i].capacity() * sizeof(uint32_t);
+        heap += mIDs[i].bucket_count() * sizeof(void *);
+        heap += mIDs[i].size() * (sizeof(std::pair<std::string_view, uint32_t>) + 2 * sizeof(void *));
+    }
+
+    return {heap, 0, 0};
+}
+
+std::string_view go::symbol::NameIndex::string(NameSpace space, uint32_t id) const {
+    return mStrings[space][id];
+}
+
+std::optional<uint32_t> go::symbol::NameIndex::find(NameSpace space, std::string_view str) const {
+    auto it = mIDs[space].find(str);
+
+    if (it == mIDs[space].end())
+        return std::nullopt;
+
+    return it->second;
+}
+
+std::optional<uint32_t> go::symbol::NameIndex::poolID(NameSpace space, uint32_t id) const {
+    if (!mPool)
+        return std::nullopt;
+
+    return mPoolIDs[space][id];
+}
+
+const go::symbol::NameComponents &go::symbol::NameIndex::operator[](size_t index) const {
+    return mComponents[index];
+}
+
+uint32_t go::symbol::NameIndex::intern(NameSpace space, std::string_view str) {
+    auto it = mIDs[space].find(str);
+
+    if (it != mIDs[space].end())
+        return it->second;
+
+    auto id = uint32_t(mStrings[space].size());
+
+    if (mPool) {
+        uint32_t pooled = mPool->acquire(str);
+
+        str = mPool->string(pooled);
+        mPoolIDs[space].push_back(pooled);
+    }
+
+    mStrings[space].push_back(str);
+    mIDs[space].emplace(str, id);
+
+    return id;
+}
@@ -0,0 +1,76 @@
+#include <go/symbol/native.h>
+#include <elf/symbol.h>
+#include <algorithm>
+
+go::symbol::NativeSymbolTable::NativeSymbolTable(const elf::Reader &reader, uint64_t base) : mBase(base) {
+    std::vector<Entry> entries;
+
+    for (const auto &section: reader.sections()) {
+        if (section->type() != SHT_SYMTAB && section->type() != SHT_DYNSYM)
+            continue;
+
+        elf::SymbolTable symbolTable(reader, section);
+
+        for (const auto &symbol: symbolTable) {
+            if (ELF64_ST_TYPE(symbol->info()) != STT_FUNC || symbol->sectionIndex() == SHN_UNDEF || !symbol->value())
+                continue;
+
+            entries.push_back({
+                    symbol->value(),
+                    (uint32_t) std::min<uint64_t>(symbol->size(), UINT32_MAX),
+                    (uint32_t) mNames.size()
+            });
+
+            mNames += symbol->name();
+            mNames += '\0';
+        }
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const auto &lhs, const auto &rhs) {
+        if (lhs.address != rhs.address)
+            return lhs.address < rhs.address;
+
+        return lhs.size > rhs.size;
+    });
+
+    entries.erase(std::unique(entries.begin(), entries.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.address == rhs.address;
+    }), entries.end());
+
+    for (size_t i = 0; i + 1 < entries.size(); i++) {
+        if (entries[i].size)
+            continue;
+
+        entries[i].size = (uint32_t) std::min<uint64_t>(entries[i + 1].address - entries[i].address, UINT32_MAX);
+    }
+
+    entries.shrink_to_fit();
+    mEntries = std::move(entries);
+}
+
+size_t go::symbol::NativeSymbolTable::size() const {
+    return mEntries.size();
+}
+
+std::optional<go::symbol::NativeSymbol> go::symbol::NativeSymbolTable::find(uint64_t address) const {
+    uint64_t target = address - mBase;
+
+    auto it = std::upper_bound(mEntries.begin(), mEntries.end(), target, [](uint64_t value, const auto &entry) {
+        return value < entry.address;
+    });
+
+    if (it == mEntries.begin())
+        return std::nullopt;
+
+    it--;
+
+    if (target >= it->address + it->size)
+        return std::nullopt;
+
+    return operator[](it - mEntries.begin());
+}
+
+go::symbol::NativeSymbol go::symbol::NativeSymbolTable::operator[](size_t index) const {
+    const Entry &entry = mEntries[index];
+    return {mBase + entry.address, entry.size, mNames.data() + entry.name};
+}
@@ -0,0 +1,268 @@
+#include <go/symbol/pprof.h>
+#include <zlib.h>
+#include <zero/log.h>
+
+constexpr auto GZIP_WINDOW_BITS = 15 + 16;
+constexpr auto OUTPUT_BUFFER_SIZE = 16384;
+
+constexpr auto LENGTH_WIRE_TYPE = 2;
+constexpr auto VARINT_WIRE_TYPE = 0;
+
+constexpr auto PROFILE_SAMPLE_TYPE = 1;
+constexpr auto PROFILE_SAMPLE = 2;
+constexpr auto PROFILE_LOCATION = 4;
+constexpr auto PROFILE_FUNCTION = 5;
+constexpr auto PROFILE_STRING_TABLE = 6;
+constexpr auto PROFILE_PERIOD_TYPE = 11;
+constexpr auto PROFILE_PERIOD = 12;
+
+static void varint(std::string &output, uint64_t value) {
+    while (value >= 0x80) {
+        output += char(value | 0x80);
+        value >>= 7;
+    }
+
+    output += char(value);
+}
+
+static void key(std::string &output, int field, int type) {
+    varint(output, (uint64_t(field) << 3) | type);
+}
+
+static void integer(std::string &output, int field, uint64_t value) {
+    if (!value)
+        return;
+
+    key(output, field, VARINT_WIRE_TYPE);
+    varint(output, value);
+}
+
+static void bytes(std::string &output, int field, std::string_view value) {
+    key(output, field, LENGTH_WIRE_TYPE);
+    varint(output, value.size());
+    output.append(value);
+}
+
+go::symbol::ProfileWriter::ProfileWriter(const SymbolTable *table, std::ostream &stream, bool compress)
+        : mTable(table), mStream(stream), mFinished(false), mFunctions(table->size()) {
+    if (compress) {
+        mZStream = std::make_unique<z_stream>();
+        mOutput.resize(OUTPUT_BUFFER_SIZE);
+
+        if (deflateInit2(mZStream.get(), Z_DEFAULT_COMPRESSION, Z_DEFLATED, GZIP_WINDOW_BITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            LOG_ERROR("init deflate stream failed");
+            mZStream.reset();
+            mFinished = true;
+            return;
+        }
+    }
+
+    string("");
+}
+
+go::symbol::ProfileWriter::~ProfileWriter() {
+    if (mZStream)
+        deflateEnd(mZStream.get());
+}
+
+bool go::symbol::ProfileWriter::sampleType(std::string_view type, std::string_view unit) {
+    return valueType(PROFILE_SAMPLE_TYPE, type, unit);
+}
+
+bool go::symbol::ProfileWriter::period(std::string_view type, std::string_view unit, int64_t period) {
+    if (!valueType(PROFILE_PERIOD_TYPE, type, unit))
+        return false;
+
+    mMessage.clear();
+    integer(mMessage, PROFILE_PERIOD, period);
+
+    return write(mMessage.data(), mMessage.size());
+}
+
+bool go::symbol::ProfileWriter::sample(std::span<const uint64_t> stack, std::span<const int64_t> values) {
+    mLocationIDs.clear();
+
+    for (const auto &pc: stack)
+        mLocationIDs.push_back(location(pc));
+
+    mSubMessage.clear();
+
+    for (const auto &id: mLocationIDs)
+        varint(mSubMessage, id);
+
+    mMessage.clear();
+    bytes(mMessage, 1, mSubMessage);
+
+    mSubMessage.clear();
+
+    for (const auto &value: values)
+        varint(mSubMessage, value);
+
+    bytes(mMessage, 2, mSubMessage);
+
+    return message(PROFILE_SAMPLE, mMessage);
+}
+
+bool go::symbol::ProfileWriter::finish() {
+    if (mFinished)
+        return false;
+
+    mFinished = true;
+
+    if (!mZStream) {
+        mStream.flush();
+        return mStream.good();
+    }
+
+    int status;
+
+    do {
+        mZStream->next_out = (Bytef *) mOutput.data();
+        mZStream->avail_out = mOutput.size();
+
+        status = deflate(mZStream.get(), Z_FINISH);
+
+        if (status == Z_STREAM_ERROR) {
+            LOG_ERROR("finish deflate stream failed");
+            return false;
+        }
+
+        mStream.write((const char *) mOutput.data(), std::streamsize(mOutput.size() - mZStream->avail_out));
+    } while (status != Z_STREAM_END);
+
+    mStream.flush();
+    return mStream.good();
+}
+
+uint64_t go::symbol::ProfileWriter::string(std::string_view str) {
+    auto it = mStrings.find(str);
+
+    if (it != mStrings.end())
+        return it->second;
+
+    uint64_t id = mStrings.size();
+    mStrings.emplace(str, id);
+
+    mMessage.clear();
+    bytes(mMessage, PROFILE_STRING_TABLE, str);
+    write(mMessage.data(), mMessage.size());
+
+    return id;
+}
+
+uint64_t go::symbol::ProfileWriter::location(uint64_t pc) {
+    auto [it, inserted] = mLocations.try_emplace(pc, mLocations.size() + 1);
+
+    if (!inserted)
+        return it->second;
+
+    uint64_t id = 0;
+    int line = 0;
+
+    auto symbolIterator = mTable->find(pc);
+
+    if (symbolIterator != mTable->end()) {
+        Symbol symbol = (*symbolIterator).symbol();
+        id = function(symbolIterator - mTable->begin(), symbol);
+
+        if (mTable->capabilities() & PCValueCapability)
+            line = std::max(symbol.sourceLine(pc), 0);
+    }
+
+    mRecord.clear();
+
+    integer(mRecord, 1, it->second);
+    integer(mRecord, 3, pc);
+
+    if (id) {
+        mSubMessage.clear();
+
+        integer(mSubMessage, 1, id);
+        integer(mSubMessage, 2, line);
+
+        bytes(mRecord, 4, mSubMessage);
+    }
+
+    message(PROFILE_LOCATION, mRecord);
+    return it->second;
+}
+
+uint64_t go::symbol::ProfileWriter::function(size_t index, const Symbol &symbol) {
+    uint64_t id = index + 1;
+
+    if (mFunctions[index])
+        return id;
+
+    mFunctions[index] = true;
+
+    uint64_t name = string(symbol.name());
+    uint64_t file = 0;
+    int line = 0;
+
+    if (mTable->capabilities() & FileCapability) {
+        const char *source = symbol.sourceFile(symbol.entry());
+
+        if (source)
+            file = string(source);
+    }
+
+    if (mTable->capabilities() & PCValueCapability)
+        line = std::max(symbol.sourceLine(symbol.entry()), 0);
+
+    mRecord.clear();
+
+    integer(mRecord, 1, id);
+    integer(mRecord, 2, name);
+    integer(mRecord, 3, name);
+    integer(mRecord, 4, file);
+    integer(mRecord, 5, line);
+
+    message(PROFILE_FUNCTION, mRecord);
+    return id;
+}
+
+bool go::symbol::ProfileWriter::valueType(int field, std::string_view type, std::string_view unit) {
+    uint64_t typeID = string(mOwned.emplace_back(type));
+    uint64_t unitID = string(mOwned.emplace_back(unit));
+
+    mMessage.clear();
+
+    integer(mMessage, 1, typeID);
+    integer(mMessage, 2, unitID);
+
+    return message(field, mMessage);
+}
+
+bool go::symbol::ProfileWriter::message(int field, const std::string &message) {
+    mSubMessage.clear();
+    bytes(mSubMessage, field, message);
+
+    return write(mSubMessage.data(), mSubMessage.size());
+}
+
+bool go::symbol::ProfileWriter::write(const void *data, size_t size) {
+    if (mFinished)
+        return false;
+
+    if (!mZStream) {
+        mStream.write((const char *) data, std::streamsize(size));
+        return mStream.good();
+    }
+
+    mZStream->next_in = (Bytef *) data;
+    mZStream->avail_in = size;
+
+    while (mZStream->avail_in) {
+        mZStream->next_out = (Bytef *) mOutput.data();
+        mZStream->avail_out = mOutput.size();
+
+        if (deflate(mZStream.get(), Z_NO_FLUSH) == Z_STREAM_ERROR) {
+            LOG_ERROR("deflate stream failed");
+            return false;
+        }
+
+        mStream.write((const char *) mOutput.data(), std::streamsize(mOutput.size() - mZStream->avail_out));
+    }
+
+    return mStream.good();
+}
@@ -0,0 +1,18 @@
+#ifndef GO_SYMBOL_PROBE_H
+#define GO_SYMBOL_PROBE_H
+
+#if defined(GO_SYMBOL_ENABLE_PROBES) && __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+
+#define GO_SYMBOL_PROBE1(name, a) DTRACE_PROBE1(go_symbol, name, a)
+#define GO_SYMBOL_PROBE2(name, a, b) DTRACE_PROBE2(go_symbol, name, a, b)
+#define GO_SYMBOL_PROBE3(name, a, b, c) DTRACE_PROBE3(go_symbol, name, a, b, c)
+#define GO_SYMBOL_PROBE4(name, a, b, c, d) DTRACE_PROBE4(go_symbol, name, a, b, c, d)
+#else
+#define GO_SYMBOL_PROBE1(name, a) ((void) 0)
+#define GO_SYMBOL_PROBE2(name, a, b) ((void) 0)
+#define GO_SYMBOL_PROBE3(name, a, b, c) ((void) 0)
+#define GO_SYMBOL_PROBE4(name, a, b, c, d) ((void) 0)
+#endif
+
+#endif //GO_SYMBOL_PROBE_H
@@ -1,4 +1,7 @@
 #include <go/symbol/reader.h>
+#include "probe.h"
+#include "locate.h"
+#include "compression.h"
 #include <elf/symbol.h>
 #include <zero/log.h>
 #include <algorithm>
@@ -12,11 +15,13 @@
 constexpr auto SYMBOL_SECTION = "gopclntab";
 constexpr auto BUILD_INFO_SECTION = "buildinfo";
 constexpr auto INTERFACE_SECTION = "itablink";
+constexpr auto TYPE_LINK_SECTION = "typelink";
 
 constexpr auto BUILD_INFO_MAGIC = "\xff Go buildinf:";
 constexpr auto BUILD_INFO_MAGIC_SIZE = 14;
 
 constexpr auto TYPES_SYMBOL = "runtime.types";
+constexpr auto ETYPES_SYMBOL = "runtime.etypes";
 constexpr auto VERSION_SYMBOL = "runtime.buildVersion";
 
 constexpr auto SYMBOL_MAGIC_12 = 0xfffffffb;
@@ -24,11 +29,77 @@ constexpr auto SYMBOL_MAGIC_116 = 0xfffffffa;
 constexpr auto SYMBOL_MAGIC_118 = 0xfffffff0;
 constexpr auto SYMBOL_MAGIC_120 = 0xfffffff1;
 
+static std::optional<go::symbol::SymbolVersion> symbolVersion(uint32_t magic) {
+    switch (magic) {
+        case SYMBOL_MAGIC_12:
+            return go::symbol::VERSION12;
+
+        case SYMBOL_MAGIC_116:
+            return go::symbol::VERSION116;
+
+        case SYMBOL_MAGIC_118:
+            return go::symbol::VERSION118;
+
+        case SYMBOL_MAGIC_120:
+            return go::symbol::VERSION120;
+
+        default:
+            return std::nullopt;
+    }
+}
+
+static std::optional<go::symbol::SymbolLocation>
+locateSymbols(const elf::Reader &reader, go::endian::Converter converter) {
+    for (const auto &segment: reader.segments()) {
+        if (segment->type() != PT_LOAD || (segment->flags() & PF_W))
+            continue;
+
+        std::optional<size_t> offset = go::symbol::findSymbolHeader(
+                {segment->data(), segment->fileSize()},
+                converter
+        );
+
+        if (offset)
+            return go::symbol::SymbolLocation{segment, *offset};
+    }
+
+    return std::nullopt;
+}
+
+static std::optional<go::symbol::ModuleData> moduleData(const elf::Reader &reader, go::endian::Converter converter) {
+    std::optional<go::symbol::SymbolLocation> location = locateSymbols(reader, converter);
+
+    if (!location)
+        return std::nullopt;
+
+    for (const auto &segment: reader.segments()) {
+        if (segment->type() != PT_LOAD || !(segment->flags() & PF_W))
+            continue;
+
+        std::optional<go::symbol::ModuleData> moduleData = go::symbol::findModuleData(
+                reader,
+                segment,
+                *location,
+                converter
+        );
+
+        if (moduleData)
+            return moduleData;
+    }
+
+    return std::nullopt;
+}
+
 go::symbol::Reader::Reader(elf::Reader reader, std::filesystem::path path)
         : mReader(std::move(reader)), mPath(std::move(path)) {
 
 }
 
+go::symbol::Reader::Reader(elf::Reader reader, std::filesystem::path path, std::shared_ptr<void> handle)
+        : mReader(std::move(reader)), mPath(std::move(path)), mHandle(std::move(handle)) {
+
+}
+
 size_t go::symbol::Reader::ptrSize() {
     return mReader.header()->ident()[EI_CLASS] == ELFCLASS64 ? 8 : 4;
 }
@@ -85,6 +156,66 @@ std::optional<go::Version> go::symbol::Reader::version() {
     return parseVersion({(char *) buffer->data(), buffer->size()});
 }
 
+go::memory::Usage go::symbol::Reader::memoryUsage() {
+    memory::Usage usage = {};
+    std::vector<std::pair<uint64_t, std::span<const std::byte>>> regions;
+
+    for (const auto &segment: mReader.segments()) {
+        if (segment->type() != PT_LOAD || !segment->fileSize())
+            continue;
+
+        regions.emplace_back(segment->offset(), std::span<const std::byte>{segment->data(), segment->fileSize()});
+    }
+
+    for (const auto &section: mReader.sections()) {
+        if (section->type() == SHT_NOBITS || !section->size())
+            continue;
+
+        regions.emplace_back(section->offset(), std::span<const std::byte>{section->data(), section->size()});
+    }
+
+    std::sort(regions.begin(), regions.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    uint64_t start = 0;
+    uint64_t end = 0;
+    const std::byte *data = nullptr;
+
+    auto account = [&]() {
+        if (!data || end <= start)
+            return;
+
+        usage.mapped += end - start;
+        usage.resident += memory::resident({data, end - start}).value_or(0);
+    };
+
+    for (const auto &[offset, region]: regions) {
+        if (data && offset <= end) {
+            end = std::max<uint64_t>(end, offset + region.size());
+            continue;
+        }
+
+        account();
+
+        start = offset;
+        end = offset + region.size();
+        data = region.data();
+    }
+
+    account();
+
+    if (mHandle) {
+        std::error_code ec;
+        uintmax_t size = std::filesystem::file_size(mPath, ec);
+
+        if (!ec)
+            usage.heap = size;
+    }
+
+    return usage;
+}
+
 std::optional<go::symbol::BuildInfo> go::symbol::Reader::buildInfo() {
     std::vector<std::shared_ptr<elf::ISection>> sections = mReader.sections();
 
@@ -97,6 +228,16 @@ std::optional<go::symbol::BuildInfo> go::symbol::Reader::buildInfo() {
     );
 
     if (it == sections.end()) {
+        for (const auto &segment: mReader.segments()) {
+            if (segment->type() != PT_LOAD)
+                continue;
+
+            std::optional<size_t> offset = findBuildInfo({segment->data(), segment->fileSize()});
+
+            if (offset)
+                return BuildInfo(mReader, segment->data() + *offset);
+        }
+
         LOG_ERROR("build info section not found");
         return std::nullopt;
     }
@@ -120,41 +261,47 @@ std::optional<go::symbol::seek::SymbolTable> go::symbol::Reader::symbols(uint64_
             }
     );
 
-    if (it == sections.end()) {
-        LOG_ERROR("symbol section not found");
-        return std::nullopt;
-    }
-
-    const std::byte *data = it->operator*().data();
-
     elf::endian::Type endian = this->endian();
     endian::Converter converter(endian);
 
-    uint32_t magic = converter(*(uint32_t *) data);
+    std::optional<SymbolLocation> location;
 
-    SymbolVersion version;
+    if (it == sections.end()) {
+        location = locateSymbols(mReader, converter);
 
-    switch (magic) {
-        case SYMBOL_MAGIC_12:
-            version = VERSION12;
-            break;
+        if (!location) {
+            LOG_ERROR("symbol section not found");
+            return std::nullopt;
+        }
+    }
 
-        case SYMBOL_MAGIC_116:
-            version = VERSION116;
-            break;
+    std::shared_ptr<CompressedSection> compressed;
 
-        case SYMBOL_MAGIC_118:
-            version = VERSION118;
-            break;
+    if (!location && (it->operator*().flags() & SHF_COMPRESSED)) {
+        std::optional<CompressedData> compressedData = go::symbol::compressedData(*it, converter, ptrSize());
 
-        case SYMBOL_MAGIC_120:
-            version = VERSION120;
-            break;
+        if (!compressedData)
+            return std::nullopt;
 
-        default:
+        compressed = std::make_shared<CompressedSection>(*it, *compressedData);
+    }
+
+    uint32_t magic = 0;
+
+    if (compressed) {
+        if (compressed->read(&magic, sizeof(uint32_t)) != sizeof(uint32_t)) {
+            LOG_ERROR("decompress symbol section failed");
             return std::nullopt;
+        }
+    } else {
+        magic = *(uint32_t *) (location ? location->data() : it->operator*().data());
     }
 
+    std::optional<SymbolVersion> version = symbolVersion(converter(magic));
+
+    if (!version)
+        return std::nullopt;
+
     bool dynamic = mReader.header()->type() == ET_DYN;
 
     std::vector<std::shared_ptr<elf::ISegment>> loads;
@@ -177,6 +324,18 @@ std::optional<go::symbol::seek::SymbolTable> go::symbol::Reader::symbols(uint64_
             }
     )->operator*().virtualAddress() & ~(PAGE_SIZE - 1);
 
+    if (compressed) {
+        uint64_t address = it->operator*().address();
+        seek::SymbolTable table(*version, converter, std::move(compressed), address, dynamic ? base - minVA : 0);
+
+        if (!table.valid())
+            return std::nullopt;
+
+        GO_SYMBOL_PROBE3(symbols, -1, *version, table.size());
+
+        return table;
+    }
+
     std::ifstream stream(mPath);
 
     if (!stream.is_open()) {
@@ -184,17 +343,29 @@ std::optional<go::symbol::seek::SymbolTable> go::symbol::Reader::symbols(uint64_
         return std::nullopt;
     }
 
-    return seek::SymbolTable(
-            version,
+    seek::SymbolTable table(
+            *version,
             converter,
             std::move(stream),
-            (std::streamoff) it.operator*()->offset(),
-            it->operator*().address(),
+            (std::streamoff) (location ? location->fileOffset() : it.operator*()->offset()),
+            location ? location->address() : it->operator*().address(),
             dynamic ? base - minVA : 0
     );
+
+    if (!table.valid())
+        return std::nullopt;
+
+    GO_SYMBOL_PROBE3(symbols, -1, *version, table.size());
+
+    return table;
 }
 
 std::optional<go::symbol::SymbolTable> go::symbol::Reader::symbols(AccessMethod method, uint64_t base) {
+    return symbols(method, {}, base);
+}
+
+std::optional<go::symbol::SymbolTable>
+go::symbol::Reader::symbols(AccessMethod method, const SymbolOptions &options, uint64_t base) {
     std::vector<std::shared_ptr<elf::ISection>> sections = mReader.sections();
 
     auto it = std::find_if(
@@ -205,41 +376,68 @@ std::optional<go::symbol::SymbolTable> go::symbol::Reader::symbols(AccessMethod
             }
     );
 
+    elf::endian::Type endian = this->endian();
+    endian::Converter converter(endian);
+
+    std::optional<SymbolLocation> location;
+
     if (it == sections.end()) {
-        LOG_ERROR("symbol section not found");
-        return std::nullopt;
+        location = locateSymbols(mReader, converter);
+
+        if (!location) {
+            LOG_ERROR("symbol section not found");
+            return std::nullopt;
+        }
     }
 
-    const std::byte *data = it->operator*().data();
+    auto allocate = [&](size_t size) -> std::optional<memory::Buffer> {
+        if (!options.region.empty())
+            return memory::borrow(options.region, size);
 
-    elf::endian::Type endian = this->endian();
-    endian::Converter converter(endian);
+        if (options.allocator)
+            return memory::allocate(size, options.allocator);
 
-    uint32_t magic = converter(*(uint32_t *) data);
+        return memory::allocate(size, options.hugePage);
+    };
 
-    SymbolVersion version;
+    std::optional<memory::Buffer> decompressed;
 
-    switch (magic) {
-        case SYMBOL_MAGIC_12:
-            version = VERSION12;
-            break;
+    if (!location && (it->operator*().flags() & SHF_COMPRESSED)) {
+        if (method == Attached) {
+            LOG_ERROR("compressed symbol section is not loaded");
+            return std::nullopt;
+        }
 
-        case SYMBOL_MAGIC_116:
-            version = VERSION116;
-            break;
+        std::optional<CompressedData> compressedData = go::symbol::compressedData(*it, converter, ptrSize());
 
-        case SYMBOL_MAGIC_118:
-            version = VERSION118;
-            break;
+        if (!compressedData)
+            return std::nullopt;
 
-        case SYMBOL_MAGIC_120:
-            version = VERSION120;
-            break;
+        decompressed = method == AnonymousMemory && options.capabilities == FullCapability ?
+                       allocate(compressedData->size) :
+                       memory::allocate(compressedData->size);
 
-        default:
+        if (!decompressed) {
+            LOG_ERROR("allocate symbol buffer failed");
             return std::nullopt;
+        }
+
+        if (!decompress(*compressedData, {decompressed->data(), decompressed->size()})) {
+            LOG_ERROR("decompress symbol section failed");
+            return std::nullopt;
+        }
     }
 
+    const std::byte *data = decompressed ? decompressed->data() :
+                            location ? location->data() : it->operator*().data();
+
+    uint32_t magic = converter(*(uint32_t *) data);
+
+    std::optional<SymbolVersion> version = symbolVersion(magic);
+
+    if (!version)
+        return std::nullopt;
+
     bool dynamic = mReader.header()->type() == ET_DYN;
 
     std::vector<std::shared_ptr<elf::ISegment>> loads;
@@ -262,18 +460,66 @@ std::optional<go::symbol::SymbolTable> go::symbol::Reader::symbols(AccessMethod
             }
     )->operator*().virtualAddress() & ~(PAGE_SIZE - 1);
 
+    if (decompressed) {
+        SymbolTable table(*version, converter, std::move(*decompressed), dynamic ? base - minVA : 0);
+
+        if (method == FileMapping || options.capabilities == FullCapability) {
+            GO_SYMBOL_PROBE3(symbols, method, *version, table.size());
+            return table;
+        }
+
+        std::optional<SymbolTable> result = table.compact(options.capabilities, allocate);
+
+        if (!result) {
+            LOG_ERROR("allocate symbol buffer failed");
+            return std::nullopt;
+        }
+
+        GO_SYMBOL_PROBE3(symbols, method, *version, result->size());
+
+        return result;
+    }
+
     if (method == FileMapping) {
-        return SymbolTable(version, converter, *it, dynamic ? base - minVA : 0);
+        SymbolTable table = location ?
+                            SymbolTable(*version, converter, location->buffer(), dynamic ? base - minVA : 0) :
+                            SymbolTable(*version, converter, *it, dynamic ? base - minVA : 0);
+
+        if (!table.prefault(options.prefault, options.prefaultCapabilities))
+            LOG_WARNING("prefault symbol table failed");
+
+        GO_SYMBOL_PROBE3(symbols, method, *version, table.size());
+
+        return table;
     } else if (method == AnonymousMemory) {
-        std::unique_ptr<std::byte[]> buffer = std::make_unique<std::byte[]>(it->operator*().size());
-        memcpy(buffer.get(), it->operator*().data(), it->operator*().size());
-        return SymbolTable(version, converter, std::move(buffer), dynamic ? base - minVA : 0);
+        SymbolTable table = location ?
+                            SymbolTable(*version, converter, location->buffer(), dynamic ? base - minVA : 0) :
+                            SymbolTable(*version, converter, *it, dynamic ? base - minVA : 0);
+
+        std::optional<SymbolTable> result = table.compact(options.capabilities, allocate);
+
+        if (!result) {
+            LOG_ERROR("allocate symbol buffer failed");
+            return std::nullopt;
+        }
+
+        GO_SYMBOL_PROBE3(symbols, method, *version, result->size());
+
+        return result;
     }
 
-    if (!dynamic)
-        return SymbolTable(version, converter, (const std::byte *) it->operator*().address(), 0);
+    uint64_t address = location ? location->address() : it->operator*().address();
 
-    return SymbolTable(version, converter, (const std::byte *) base + it->operator*().address() - minVA, 0);
+    SymbolTable table(
+            *version,
+            converter,
+            (const std::byte *) (dynamic ? base + address - minVA : address),
+            0
+    );
+
+    GO_SYMBOL_PROBE3(symbols, method, *version, table.size());
+
+    return table;
 }
 
 std::optional<go::symbol::InterfaceTable> go::symbol::Reader::interfaces(uint64_t base) {
@@ -287,6 +533,28 @@ std::optional<go::symbol::InterfaceTable> go::symbol::Reader::interfaces(uint64_
         return std::nullopt;
     }
 
+    bool dynamic = mReader.header()->type() == ET_DYN;
+
+    std::vector<std::shared_ptr<elf::ISegment>> loads;
+    std::vector<std::shared_ptr<elf::ISegment>> segments = mReader.segments();
+
+    std::copy_if(
+            segments.begin(),
+            segments.end(),
+            std::back_inserter(loads),
+            [](const auto &segment) {
+                return segment->type() == PT_LOAD;
+            }
+    );
+
+    Elf64_Addr minVA = std::min_element(
+            loads.begin(),
+            loads.end(),
+            [](const auto &i, const auto &j) {
+                return i->virtualAddress() < j->virtualAddress();
+            }
+    )->operator*().virtualAddress() & ~(PAGE_SIZE - 1);
+
     std::vector<std::shared_ptr<elf::ISection>> sections = mReader.sections();
 
     auto it = std::find_if(
@@ -297,21 +565,30 @@ std::optional<go::symbol::InterfaceTable> go::symbol::Reader::interfaces(uint64_
             }
     );
 
-    if (it == sections.end()) {
-        LOG_ERROR("interface section not found");
-        return std::nullopt;
-    }
-
-    std::shared_ptr<elf::ISection> section = *it;
-
-    it = std::find_if(sections.begin(), sections.end(), [](const auto &section) {
+    auto symbolSection = std::find_if(sections.begin(), sections.end(), [](const auto &section) {
         return section->type() == SHT_SYMTAB;
     });
 
-    if (it == sections.end())
-        return std::nullopt;
+    if (it == sections.end() || symbolSection == sections.end()) {
+        std::optional<ModuleData> moduleData = ::moduleData(mReader, endian::Converter(endian()));
 
-    elf::SymbolTable symbolTable(mReader, *it);
+        if (!moduleData) {
+            LOG_ERROR("interface section not found");
+            return std::nullopt;
+        }
+
+        return InterfaceTable(
+                mReader,
+                moduleData->itablinks,
+                *version,
+                moduleData->types,
+                dynamic ? base - minVA : 0,
+                ptrSize(),
+                endian::Converter(endian())
+        );
+    }
+
+    elf::SymbolTable symbolTable(mReader, *symbolSection);
 
     auto symbolIterator = std::find_if(symbolTable.begin(), symbolTable.end(), [](const auto &symbol) {
         return symbol->name() == TYPES_SYMBOL;
@@ -322,6 +599,28 @@ std::optional<go::symbol::InterfaceTable> go::symbol::Reader::interfaces(uint64_
         return std::nullopt;
     }
 
+    return InterfaceTable(
+            mReader,
+            *it,
+            *version,
+            symbolIterator.operator*()->value(),
+            dynamic ? base - minVA : 0,
+            ptrSize(),
+            endian::Converter(endian())
+    );
+}
+
+std::optional<go::symbol::TypeTable> go::symbol::Reader::types(uint64_t base) {
+    std::optional<Version> version = this->version();
+
+    if (!version)
+        return std::nullopt;
+
+    if (version < Version{1, 7}) {
+        LOG_ERROR("golang %d.%d is not supported", version->major, version->minor);
+        return std::nullopt;
+    }
+
     bool dynamic = mReader.header()->type() == ET_DYN;
 
     std::vector<std::shared_ptr<elf::ISegment>> loads;
@@ -344,17 +643,123 @@ std::optional<go::symbol::InterfaceTable> go::symbol::Reader::interfaces(uint64_
             }
     )->operator*().virtualAddress() & ~(PAGE_SIZE - 1);
 
-    return InterfaceTable(
+    std::vector<std::shared_ptr<elf::ISection>> sections = mReader.sections();
+
+    auto it = std::find_if(sections.begin(), sections.end(), [](const auto &section) {
+        return section->type() == SHT_SYMTAB;
+    });
+
+    if (it == sections.end()) {
+        std::optional<ModuleData> moduleData = ::moduleData(mReader, endian::Converter(endian()));
+
+        if (!moduleData) {
+            LOG_ERROR("runtime.types not found");
+            return std::nullopt;
+        }
+
+        return TypeTable(
+                mReader,
+                moduleData->typelinks,
+                *version,
+                moduleData->types,
+                moduleData->etypes,
+                dynamic ? base - minVA : 0,
+                ptrSize(),
+                endian::Converter(endian())
+        );
+    }
+
+    elf::SymbolTable symbolTable(mReader, *it);
+
+    std::optional<uint64_t> types;
+    std::optional<uint64_t> etypes;
+
+    for (const auto &symbol: symbolTable) {
+        std::string name = symbol->name();
+
+        if (name == TYPES_SYMBOL)
+            types = symbol->value();
+        else if (name == ETYPES_SYMBOL)
+            etypes = symbol->value();
+
+        if (types && etypes)
+            break;
+    }
+
+    if (!types || !etypes || *types >= *etypes) {
+        LOG_ERROR("runtime.types not found");
+        return std::nullopt;
+    }
+
+    it = std::find_if(
+            sections.begin(),
+            sections.end(),
+            [](const auto &section) {
+                return section->name().find(TYPE_LINK_SECTION) != std::string::npos;
+            }
+    );
+
+    return TypeTable(
             mReader,
-            section,
+            it != sections.end() ? *it : nullptr,
             *version,
-            symbolIterator.operator*()->value(),
+            *types,
+            *etypes,
             dynamic ? base - minVA : 0,
             ptrSize(),
             endian::Converter(endian())
     );
 }
 
+std::optional<go::symbol::NativeSymbolTable> go::symbol::Reader::nativeSymbols(uint64_t base) {
+    std::vector<std::shared_ptr<elf::ISection>> sections = mReader.sections();
+
+    auto it = std::find_if(sections.begin(), sections.end(), [](const auto &section) {
+        return section->type() == SHT_SYMTAB || section->type() == SHT_DYNSYM;
+    });
+
+    if (it == sections.end())
+        return std::nullopt;
+
+    bool dynamic = mReader.header()->type() == ET_DYN;
+
+    std::vector<std::shared_ptr<elf::ISegment>> loads;
+    std::vector<std::shared_ptr<elf::ISegment>> segments = mReader.segments();
+
+    std::copy_if(
+            segments.begin(),
+            segments.end(),
+            std::back_inserter(loads),
+            [](const auto &segment) {
+                return segment->type() == PT_LOAD;
+            }
+    );
+
+    Elf64_Addr minVA = std::min_element(
+            loads.begin(),
+            loads.end(),
+            [](const auto &i, const auto &j) {
+                return i->virtualAddress() < j->virtualAddress();
+            }
+    )->operator*().virtualAddress() & ~(PAGE_SIZE - 1);
+
+    return NativeSymbolTable(mReader, dynamic ? base - minVA : 0);
+}
+
+std::optional<go::symbol::Symbolizer> go::symbol::Reader::symbolizer(AccessMethod method, uint64_t base) {
+    return symbolizer(method, {}, base);
+}
+
+std::optional<go::symbol::Symbolizer>
+go::symbol::Reader::symbolizer(AccessMethod method, const SymbolOptions &options, uint64_t base) {
+    std::optional<SymbolTable> symbolTable = symbols(method, options, base);
+
+    if (!symbolTable)
+        return std::nullopt;
+
+    return Symbolizer(std::move(*symbolTable), nativeSymbols(base));
+}
+
 std::optional<go::symbol::Reader> go::symbol::openFile(const std::filesystem::path &path) {
     auto readerResult = elf::openFile(path);
 
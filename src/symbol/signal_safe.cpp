@@ -0,0 +1,89 @@
+#include <go/symbol/signal_safe.h>
+#include <charconv>
+#include <cstring>
+
+static char *append(char *ptr, char *end, const char *str) noexcept {
+    size_t length = std::min(strlen(str), size_t(end - ptr));
+    memcpy(ptr, str, length);
+
+    return ptr + length;
+}
+
+go::symbol::SignalSafeSymbolizer::SignalSafeSymbolizer(const SymbolTable *table) noexcept: mTable(table) {
+
+}
+
+bool go::symbol::SignalSafeSymbolizer::symbolize(uint64_t pc, Frame &frame) const noexcept {
+    frame = {pc, 0, nullptr, nullptr, -1};
+
+    std::ptrdiff_t index = mTable->search(pc);
+
+    if (index < 0)
+        return false;
+
+    SymbolEntry entry = mTable->operator[](index);
+    Symbol symbol = entry.symbol();
+
+    frame.entry = entry.entry();
+    frame.name = symbol.name();
+
+    PCValue lines = symbol.pcValue(PCLineTable);
+
+    while (lines.next()) {
+        if (pc < lines.end()) {
+            frame.line = lines.value();
+            break;
+        }
+    }
+
+    if (!(mTable->mCapabilities & FileCapability))
+        return true;
+
+    PCValue files = symbol.pcValue(PCFileTable);
+
+    while (files.next()) {
+        if (pc >= files.end())
+            continue;
+
+        std::optional<uint32_t> key = symbol.fileKey(files.value());
+
+        if (key)
+            frame.file = mTable->file(*key);
+
+        break;
+    }
+
+    return true;
+}
+
+size_t go::symbol::SignalSafeSymbolizer::symbolize(std::span<const uint64_t> pcs, std::span<Frame> frames) const noexcept {
+    size_t count = std::min(pcs.size(), frames.size());
+
+    for (size_t i = 0; i < count; i++)
+        symbolize(pcs[i], frames[i]);
+
+    return count;
+}
+
+size_t go::symbol::SignalSafeSymbolizer::format(const Frame &frame, std::span<char> buffer) noexcept {
+    if (buffer.empty())
+        return 0;
+
+    char *ptr = buffer.data();
+    char *end = buffer.data() + buffer.size() - 1;
+
+    ptr = append(ptr, end, "0x");
+    ptr = std::to_chars(ptr, end, frame.pc, 16).ptr;
+    ptr = append(ptr, end, " ");
+    ptr = append(ptr, end, frame.name ? frame.name : "?");
+
+    if (frame.file) {
+        ptr = append(ptr, end, " ");
+        ptr = append(ptr, end, frame.file);
+        ptr = append(ptr, end, ":");
+        ptr = std::to_chars(ptr, end, frame.line, 10).ptr;
+    }
+
+    *ptr = '\0';
+    return ptr - buffer.data();
+}
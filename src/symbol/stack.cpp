@@ -0,0 +1,88 @@
+#include <go/symbol/stack.h>
+#include <algorithm>
+
+constexpr auto ROOT_NODE = UINT32_MAX;
+
+go::symbol::StackSymbolizer::StackSymbolizer(const SymbolTable *table) : mTable(table), mSymbolized(0) {
+
+}
+
+uint32_t go::symbol::StackSymbolizer::add(std::span<const uint64_t> stack) {
+    uint32_t node = ROOT_NODE;
+
+    for (auto it = stack.rbegin(); it != stack.rend(); it++) {
+        auto [pcIterator, inserted] = mPCs.try_emplace(*it, uint32_t(mFrames.size()));
+
+        if (inserted)
+            mFrames.push_back({*it, 0, nullptr, nullptr, -1});
+        else
+            GO_SYMBOL_STATS_ADD(mTable->mStats.get(), CacheHitCounter, 1);
+
+        uint64_t key = (uint64_t(node) << 32) | pcIterator->second;
+        auto [nodeIterator, created] = mChildren.try_emplace(key, uint32_t(mNodes.size()));
+
+        if (created)
+            mNodes.push_back({node, pcIterator->second});
+
+        node = nodeIterator->second;
+    }
+
+    return node;
+}
+
+void go::symbol::StackSymbolizer::symbolize() {
+    if (mSymbolized == mFrames.size())
+        return;
+
+    std::vector<uint32_t> pending(mFrames.size() - mSymbolized);
+
+    for (size_t i = 0; i < pending.size(); i++)
+        pending[i] = uint32_t(mSymbolized + i);
+
+    std::sort(pending.begin(), pending.end(), [this](uint32_t lhs, uint32_t rhs) {
+        return mFrames[lhs].pc < mFrames[rhs].pc;
+    });
+
+    int capabilities = mTable->capabilities();
+
+    for (const auto &id: pending) {
+        Frame &frame = mFrames[id];
+        auto it = mTable->find(frame.pc);
+
+        if (it == mTable->end())
+            continue;
+
+        SymbolEntry entry = *it;
+        Symbol symbol = entry.symbol();
+
+        frame.entry = entry.entry();
+        frame.name = symbol.name();
+
+        if (capabilities & PCValueCapability)
+            frame.line = symbol.sourceLine(frame.pc);
+
+        if (capabilities & FileCapability)
+            frame.file = symbol.sourceFile(frame.pc);
+    }
+
+    mSymbolized = mFrames.size();
+}
+
+size_t go::symbol::StackSymbolizer::size() const {
+    return mFrames.size();
+}
+
+const go::symbol::Frame &go::symbol::StackSymbolizer::frame(uint32_t id) const {
+    return mFrames[id];
+}
+
+std::vector<uint32_t> go::symbol::StackSymbolizer::stack(uint32_t id) const {
+    std::vector<uint32_t> frames;
+
+    while (id != ROOT_NODE) {
+        frames.push_back(mNodes[id].frame);
+        id = mNodes[id].parent;
+    }
+
+    return frames;
+}
@@ -0,0 +1,150 @@
+#include <go/symbol/stats.h>
+#include <bit>
+#include <cstdio>
+
+constexpr auto COUNTER_NAMES = std::array{
+        "lookups_total",
+        "misses_total",
+        "pcvalue_bytes_total",
+        "varints_total",
+        "seeks_total",
+        "reads_total",
+        "cache_hits_total"
+};
+
+constexpr auto OPERATION_NAMES = std::array{
+        "find",
+        "value",
+        "read"
+};
+
+uint64_t go::symbol::Histogram::percentile(double q) const {
+    if (!count)
+        return 0;
+
+    auto target = uint64_t(q * double(count));
+    uint64_t n = 0;
+
+    for (size_t i = 0; i < buckets.size(); i++) {
+        n += buckets[i];
+
+        if (n > target)
+            return upperBound(i);
+    }
+
+    return upperBound(buckets.size() - 1);
+}
+
+size_t go::symbol::Histogram::bucket(uint64_t value) {
+    if (value < (1 << HISTOGRAM_SUB_BITS))
+        return value;
+
+    int exponent = std::bit_width(value) - 1;
+
+    if (exponent >= HISTOGRAM_MAX_BITS)
+        return HISTOGRAM_BUCKETS - 1;
+
+    uint64_t sub = (value >> (exponent - HISTOGRAM_SUB_BITS)) & ((1 << HISTOGRAM_SUB_BITS) - 1);
+    return ((exponent - HISTOGRAM_SUB_BITS + 1) << HISTOGRAM_SUB_BITS) + sub;
+}
+
+uint64_t go::symbol::Histogram::upperBound(size_t bucket) {
+    if (bucket < (1 << HISTOGRAM_SUB_BITS))
+        return bucket + 1;
+
+    size_t exponent = (bucket >> HISTOGRAM_SUB_BITS) + HISTOGRAM_SUB_BITS - 1;
+    uint64_t sub = bucket & ((1 << HISTOGRAM_SUB_BITS) - 1);
+
+    return ((1 << HISTOGRAM_SUB_BITS) + sub + 1) << (exponent - HISTOGRAM_SUB_BITS);
+}
+
+void go::symbol::Stats::add(Counter counter, uint64_t n) {
+    mShards[shard()].counters[counter].fetch_add(n, std::memory_order_relaxed);
+}
+
+void go::symbol::Stats::record(Operation operation, uint64_t nanoseconds) {
+    Shard &shard = mShards[Stats::shard()];
+
+    shard.sums[operation].fetch_add(nanoseconds, std::memory_order_relaxed);
+    shard.buckets[operation][Histogram::bucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+}
+
+go::symbol::Snapshot go::symbol::Stats::snapshot() const {
+    Snapshot snapshot = {};
+
+    for (const auto &shard: mShards) {
+        for (size_t i = 0; i < CounterCount; i++)
+            snapshot.counters[i] += shard.counters[i].load(std::memory_order_relaxed);
+
+        for (size_t i = 0; i < OperationCount; i++) {
+            Histogram &histogram = snapshot.latencies[i];
+            histogram.sum += shard.sums[i].load(std::memory_order_relaxed);
+
+            for (size_t j = 0; j < HISTOGRAM_BUCKETS; j++) {
+                uint64_t n = shard.buckets[i][j].load(std::memory_order_relaxed);
+
+                histogram.buckets[j] += n;
+                histogram.count += n;
+            }
+        }
+    }
+
+    return snapshot;
+}
+
+size_t go::symbol::Stats::shard() {
+    static std::atomic<size_t> next;
+    thread_local size_t index = next.fetch_add(1, std::memory_order_relaxed) % std::tuple_size_v<decltype(mShards)>;
+
+    return index;
+}
+
+static std::string seconds(uint64_t nanoseconds) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.9g", double(nanoseconds) / 1e9);
+    return buffer;
+}
+
+go::symbol::Timer::Timer(Stats *stats, Operation operation)
+        : mStats(stats), mOperation(operation), mStart(std::chrono::steady_clock::now()) {
+
+}
+
+go::symbol::Timer::~Timer() {
+    mStats->record(
+            mOperation,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mStart).count()
+    );
+}
+
+std::string go::symbol::prometheus(const Snapshot &snapshot, std::string_view prefix) {
+    std::string text;
+    std::string name(prefix);
+
+    for (size_t i = 0; i < CounterCount; i++) {
+        text += "# TYPE " + name + "_" + COUNTER_NAMES[i] + " counter\n";
+        text += name + "_" + COUNTER_NAMES[i] + " " + std::to_string(snapshot.counters[i]) + "\n";
+    }
+
+    text += "# TYPE " + name + "_latency_seconds histogram\n";
+
+    for (size_t i = 0; i < OperationCount; i++) {
+        const Histogram &histogram = snapshot.latencies[i];
+        std::string label = std::string("operation=\"") + OPERATION_NAMES[i] + "\"";
+
+        uint64_t n = 0;
+
+        for (size_t j = 0; j < HISTOGRAM_BUCKETS - 1; j++) {
+            n += histogram.buckets[j];
+
+            text += name + "_latency_seconds_bucket{" + label + ",le=\"" +
+                    seconds(Histogram::upperBound(j)) + "\"} " + std::to_string(n) + "\n";
+        }
+
+        text += name + "_latency_seconds_bucket{" + label + ",le=\"+Inf\"} " + std::to_string(histogram.count) + "\n";
+        text += name + "_latency_seconds_sum{" + label + "} " + seconds(histogram.sum) + "\n";
+        text += name + "_latency_seconds_count{" + label + "} " + std::to_string(histogram.count) + "\n";
+    }
+
+    return text;
+}
@@ -0,0 +1,115 @@
+#include <go/symbol/string_pool.h>
+#include <mutex>
+#include <cstring>
+#include <cassert>
+
+constexpr auto SHARD_BITS = 6;
+constexpr auto SHARD_COUNT = 1u << SHARD_BITS;
+
+go::symbol::StringPool::StringPool() : mShards(std::make_unique<Shard[]>(SHARD_COUNT)) {
+
+}
+
+uint32_t go::symbol::StringPool::acquire(std::string_view str) {
+    size_t shard = std::hash<std::string_view>{}(str) & (SHARD_COUNT - 1);
+    Shard &s = mShards[shard];
+
+    std::lock_guard guard(s.mutex);
+
+    auto it = s.ids.find(str);
+
+    if (it != s.ids.end()) {
+        s.entries[it->second].references++;
+        return (it->second << SHARD_BITS) | shard;
+    }
+
+    uint32_t index;
+
+    if (!s.free.empty()) {
+        index = s.free.back();
+        s.free.pop_back();
+    } else {
+        index = uint32_t(s.entries.size());
+        s.entries.emplace_back();
+    }
+
+    Entry &entry = s.entries[index];
+
+    entry.data = std::make_unique<char[]>(str.size() + 1);
+    entry.size = uint32_t(str.size());
+    entry.references = 1;
+
+    memcpy(entry.data.get(), str.data(), str.size());
+    s.ids.emplace(std::string_view{entry.data.get(), entry.size}, index);
+
+    return (index << SHARD_BITS) | shard;
+}
+
+void go::symbol::StringPool::retain(uint32_t id) {
+    Shard &s = mShards[id & (SHARD_COUNT - 1)];
+    std::lock_guard guard(s.mutex);
+
+    size_t index = id >> SHARD_BITS;
+    assert(index < s.entries.size() && s.entries[index].references > 0);
+
+    if (index >= s.entries.size() || !s.entries[index].references)
+        return;
+
+    s.entries[index].references++;
+}
+
+void go::symbol::StringPool::release(uint32_t id) {
+    Shard &s = mShards[id & (SHARD_COUNT - 1)];
+    std::lock_guard guard(s.mutex);
+
+    size_t index = id >> SHARD_BITS;
+    assert(index < s.entries.size() && s.entries[index].references > 0);
+
+    if (index >= s.entries.size() || !s.entries[index].references)
+        return;
+
+    Entry &entry = s.entries[index];
+
+    if (--entry.references)
+        return;
+
+    s.ids.erase(std::string_view{entry.data.get(), entry.size});
+    s.free.push_back(index);
+
+    entry.data.reset();
+    entry.size = 0;
+}
+
+std::string_view go::symbol::StringPool::string(uint32_t id) const {
+    const Shard &s = mShards[id & (SHARD_COUNT - 1)];
+    std::shared_lock guard(s.mutex);
+
+    const Entry &entry = s.entries[id >> SHARD_BITS];
+    return {entry.data.get(), entry.size};
+}
+
+go::symbol::StringPoolUsage go::symbol::StringPool::usage() const {
+    StringPoolUsage usage = {};
+
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        const Shard &s = mShards[i];
+        std::shared_lock guard(s.mutex);
+
+        for (const auto &entry: s.entries) {
+            if (!entry.references)
+                continue;
+
+            usage.strings++;
+            usage.bytes += entry.size + 1;
+            usage.references += entry.references;
+            usage.referencedBytes += size_t(entry.size + 1) * entry.references;
+        }
+    }
+
+    return usage;
+}
+
+go::symbol::StringPool &go::symbol::StringPool::global() {
+    static StringPool pool;
+    return pool;
+}
@@ -1,10 +1,20 @@
 #include <go/symbol/symbol.h>
 #include <go/binary.h>
+#include "probe.h"
+#include "compression.h"
+#include <zero/log.h>
 #include <algorithm>
+#include <bit>
 #include <cstring>
 #include <unistd.h>
+#include <sys/mman.h>
+
+#ifndef PAGE_SIZE
+#define PAGE_SIZE 0x1000
+#endif
 
 constexpr auto MAX_VAR_INT_LENGTH = 10;
+constexpr auto FUNC_TABLE_BLOCK_SIZE = 64;
 
 constexpr auto STACK_TOP_FUNCTION = {
         "runtime.mstart",
@@ -17,6 +27,144 @@ constexpr auto STACK_TOP_FUNCTION = {
         "runtime.goexit"
 };
 
+constexpr auto RUNTIME_PACKAGE_PREFIX = {
+        "runtime.",
+        "runtime/internal/",
+        "internal/runtime/"
+};
+
+constexpr auto WRAPPER_FUNCTION_SUFFIX = "-fm";
+constexpr auto AUTOGENERATED_FILE = "<autogenerated>";
+constexpr auto ASM_FILE_SUFFIX = ".s";
+
+constexpr auto TOP_FRAME_FLAG = 0x1;
+constexpr auto ASM_FLAG = 0x4;
+
+namespace {
+    struct PackedField {
+        int64_t stride;
+        uint8_t bits;
+        uint8_t shift;
+    };
+
+    PackedField packField(std::span<const uint64_t> values) {
+        int64_t stride = 0;
+
+        for (size_t i = 1; i < values.size(); i++) {
+            int64_t delta = int64_t(values[i] - values[0]);
+            int64_t slope = delta / int64_t(i);
+
+            if (delta < slope * int64_t(i))
+                slope--;
+
+            stride = i == 1 ? slope : std::min(stride, slope);
+        }
+
+        uint64_t residuals = 0;
+        uint64_t max = 0;
+
+        for (size_t i = 0; i < values.size(); i++) {
+            uint64_t residual = values[i] - values[0] - uint64_t(stride * int64_t(i));
+            residuals |= residual;
+            max = std::max(max, residual);
+        }
+
+        auto shift = uint8_t(residuals ? std::countr_zero(residuals) : 0);
+        return {stride, uint8_t(std::bit_width(max >> shift)), shift};
+    }
+
+    void appendBits(std::vector<std::byte> &out, uint64_t &position, uint64_t value, uint8_t width) {
+        for (int i = 0; i < width;) {
+            size_t index = position / 8;
+            int offset = int(position % 8);
+            int n = std::min(8 - offset, width - i);
+
+            if (index >= out.size())
+                out.push_back(std::byte{0});
+
+            out[index] |= std::byte(((value >> i) & ((1u << n) - 1)) << offset);
+
+            i += n;
+            position += n;
+        }
+    }
+
+    uint64_t extractBits(const std::byte *data, uint64_t position, uint8_t width) {
+        if (width == 0)
+            return 0;
+
+        uint64_t value = 0;
+        const std::byte *ptr = data + position / 8;
+
+        for (int i = 0; i < 8; i++)
+            value |= uint64_t(std::to_integer<uint8_t>(ptr[i])) << (i * 8);
+
+        return (value >> (position % 8)) & ((uint64_t(1) << width) - 1);
+    }
+}
+
+namespace {
+    template<elf::endian::Type Endian, typename Word>
+    struct Functab {
+        static constexpr size_t size = sizeof(Word);
+
+        static uint64_t word(const std::byte *buffer) {
+            Word word;
+            memcpy(&word, buffer, sizeof(Word));
+            return elf::endian::convert<Endian>(word);
+        }
+
+        static size_t search(const std::byte *buffer, size_t count, uint64_t target) {
+            size_t low = 0;
+            size_t length = count + 1;
+
+            while (length > 1) {
+                size_t half = length / 2;
+                low = word(buffer + (low + half) * 2 * sizeof(Word)) <= target ? low + half : low;
+                length -= half;
+            }
+
+            return low;
+        }
+    };
+
+    template<typename F>
+    decltype(auto) dispatch(elf::endian::Type endian, size_t size, F &&f) {
+        if (endian == elf::endian::Big)
+            return size == 8 ? f(Functab<elf::endian::Big, uint64_t>{}) : f(Functab<elf::endian::Big, uint32_t>{});
+
+        return size == 8 ? f(Functab<elf::endian::Little, uint64_t>{}) : f(Functab<elf::endian::Little, uint32_t>{});
+    }
+
+    go::symbol::TableLayout layout(go::symbol::SymbolVersion version, elf::endian::Type endian, uint32_t ptrSize) {
+        bool big = endian == elf::endian::Big;
+        bool swap = big != (std::endian::native == std::endian::big);
+
+        if (version >= go::symbol::VERSION118 || ptrSize == 4)
+            return {swap, 4, 0, 0, 0};
+
+        return {swap, 8, big ? 32u : 0u, big ? 0u : 32u, UINT64_MAX};
+    }
+
+    uint32_t read32(const go::symbol::TableLayout &layout, const std::byte *buffer) {
+        uint32_t value;
+        memcpy(&value, buffer, sizeof(uint32_t));
+
+        return layout.swap ? std::byteswap(value) : value;
+    }
+
+    uint64_t readWord(const go::symbol::TableLayout &layout, const std::byte *buffer) {
+        uint64_t first = read32(layout, buffer);
+        uint64_t second = read32(layout, buffer + layout.size - sizeof(uint32_t));
+
+        return first << layout.firstShift | (second << layout.secondShift & layout.secondMask);
+    }
+
+    uint32_t readField(const go::symbol::TableLayout &layout, const std::byte *buffer, int n) {
+        return read32(layout, buffer + layout.size + (n - 1) * sizeof(uint32_t));
+    }
+}
+
 go::symbol::SymbolTable::SymbolTable(
         SymbolVersion version,
         endian::Converter converter,
@@ -27,6 +175,7 @@ go::symbol::SymbolTable::SymbolTable(
 
     mQuantum = std::to_integer<uint32_t>(buffer[6]);
     mPtrSize = std::to_integer<uint32_t>(buffer[7]);
+    mLayout = layout(mVersion, mConverter.endian(), mPtrSize);
 
     switch (mVersion) {
         case VERSION12: {
@@ -76,27 +225,243 @@ go::symbol::SymbolTable::SymbolTable(
             break;
         }
     }
+
+    if (mCuTable)
+        mFuncNameSize = mCuTable - mFuncNameTable;
+}
+
+go::symbol::SymbolTable::SymbolTable(const SymbolTable &table, memory::Buffer buffer, int capabilities)
+        : mVersion(table.mVersion), mConverter(table.mConverter), mMemoryBuffer(std::move(buffer)), mBase(table.mBase),
+          mLayout(table.mLayout), mQuantum(table.mQuantum), mPtrSize(table.mPtrSize), mFuncNum(table.mFuncNum),
+          mFileNum(table.mFileNum), mFuncNameSize(table.mFuncNameSize), mCapabilities(capabilities) {
+
+}
+
+std::optional<go::symbol::SymbolTable> go::symbol::SymbolTable::compact(
+        int capabilities,
+        const std::function<std::optional<memory::Buffer>(size_t)> &allocate
+) const {
+    size_t size = memorySize();
+
+    if (!size)
+        return std::nullopt;
+
+    capabilities |= NameCapability;
+
+    if (capabilities & FileCapability)
+        capabilities |= PCValueCapability;
+
+    if (mVersion == VERSION12)
+        capabilities = FullCapability;
+
+    std::vector<std::pair<const std::byte *, const std::byte *>> ranges;
+
+    for (const auto &r: regions(capabilities)) {
+        std::span<const std::byte> span = region(r);
+        ranges.emplace_back(span.data(), span.data() + span.size());
+    }
+
+    std::sort(ranges.begin(), ranges.end());
+
+    size_t length = 0;
+
+    for (const auto &[start, end]: ranges)
+        length += end - start;
+
+    std::optional<memory::Buffer> memory = allocate(length);
+
+    if (!memory)
+        return std::nullopt;
+
+    SymbolTable table(*this, std::move(*memory), capabilities);
+
+    if (!(capabilities & FileCapability)) {
+        std::span<const uint8_t> attributes = this->attributes();
+        table.mAttributes.assign(attributes.begin(), attributes.end());
+    }
+    std::byte *ptr = std::get<memory::Buffer>(table.mMemoryBuffer).data();
+
+    for (const auto &[start, end]: ranges) {
+        memcpy(ptr, start, end - start);
+        ptr += end - start;
+    }
+
+    auto rebase = [&, target = table.data()](const std::byte *address) -> const std::byte * {
+        size_t offset = 0;
+
+        for (const auto &[start, end]: ranges) {
+            if (address >= start && address < end)
+                return target + offset + (address - start);
+
+            offset += end - start;
+        }
+
+        return nullptr;
+    };
+
+    table.mFuncNameTable = rebase(mFuncNameTable);
+    table.mCuTable = rebase(mCuTable);
+    table.mFuncTable = rebase(mFuncTable);
+    table.mFuncData = rebase(mFuncData);
+    table.mPCTable = rebase(mPCTable);
+    table.mFileTable = rebase(mFileTable);
+
+    return table;
+}
+
+bool go::symbol::SymbolTable::prefault(Prefault prefault, int capabilities) const {
+    if (prefault == NoPrefault)
+        return true;
+
+    for (const auto &r: regions(capabilities)) {
+        std::span<const std::byte> span = region(r);
+
+        if (span.empty())
+            continue;
+
+        auto start = (uintptr_t) span.data() & ~uintptr_t(PAGE_SIZE - 1);
+        size_t length = (uintptr_t) span.data() + span.size() - start;
+
+        int n = 0;
+
+        switch (prefault) {
+            case WillNeedPrefault:
+                n = madvise((void *) start, length, MADV_WILLNEED);
+                break;
+
+            case PopulatePrefault:
+#ifdef MADV_POPULATE_READ
+                n = madvise((void *) start, length, MADV_POPULATE_READ);
+
+                if (n == 0 || errno != EINVAL)
+                    break;
+#endif
+                for (uintptr_t page = start; page < start + length; page += PAGE_SIZE)
+                    (void) *(volatile const std::byte *) page;
+
+                n = 0;
+                break;
+
+            case LockPrefault:
+                n = mlock((void *) start, length);
+                break;
+
+            default:
+                break;
+        }
+
+        if (n < 0) {
+            LOG_ERROR("prefault symbol region %d failed: %s", r, strerror(errno));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+go::memory::Usage go::symbol::SymbolTable::memoryUsage() const {
+    memory::Usage usage = {mAttributes.capacity(), 0, 0};
+    size_t size = memorySize();
+
+    if (mMemoryBuffer.index() == 1 && std::get<memory::Buffer>(mMemoryBuffer).backing() == memory::AnonymousBacking) {
+        usage.heap += size;
+        return usage;
+    }
+
+    usage.mapped = size;
+    usage.resident = memory::resident({data(), size}).value_or(0);
+
+    return usage;
+}
+
+std::optional<std::array<go::symbol::Residency, go::symbol::RegionCount>> go::symbol::SymbolTable::residency() const {
+    std::array<Residency, RegionCount> residency = {};
+
+    for (int i = 0; i < RegionCount; i++) {
+        std::span<const std::byte> span = region(SymbolRegion(i));
+
+        if (span.empty())
+            continue;
+
+        auto start = (uintptr_t) span.data() & ~uintptr_t(PAGE_SIZE - 1);
+        size_t length = (uintptr_t) span.data() + span.size() - start;
+
+        std::vector<unsigned char> vec((length + PAGE_SIZE - 1) / PAGE_SIZE);
+
+        if (mincore((void *) start, length, vec.data()) < 0) {
+            LOG_ERROR("query symbol region %d residency failed: %s", i, strerror(errno));
+            return std::nullopt;
+        }
+
+        residency[i].pages = vec.size();
+        residency[i].resident = std::count_if(vec.begin(), vec.end(), [](unsigned char c) {
+            return c & 1;
+        });
+    }
+
+    return residency;
 }
 
 go::symbol::SymbolIterator go::symbol::SymbolTable::find(uint64_t address) const {
-    if (address < operator[](0).entry() || address >= operator[](mFuncNum).entry())
+    GO_SYMBOL_STATS_TIMER(mStats.get(), FindOperation);
+    GO_SYMBOL_STATS_ADD(mStats.get(), LookupCounter, 1);
+
+    std::ptrdiff_t index = search(address);
+
+    if (index < 0) {
+        GO_SYMBOL_STATS_ADD(mStats.get(), MissCounter, 1);
+        GO_SYMBOL_PROBE2(find, address, -1);
         return end();
+    }
 
-    return std::upper_bound(begin(), end() + 1, address, [](uint64_t value, const auto &entry) {
-        return value < entry.entry();
-    }) - 1;
+    GO_SYMBOL_PROBE2(find, address, index);
+    return begin() + index;
 }
 
 go::symbol::SymbolIterator go::symbol::SymbolTable::find(std::string_view name) const {
-    return std::find_if(begin(), end(), [=](const auto &entry) {
+    GO_SYMBOL_STATS_ADD(mStats.get(), LookupCounter, 1);
+
+    auto it = std::find_if(begin(), end(), [=](const auto &entry) {
         return name == entry.symbol().name();
     });
+
+    if (it == end())
+        GO_SYMBOL_STATS_ADD(mStats.get(), MissCounter, 1);
+
+    return it;
 }
 
 size_t go::symbol::SymbolTable::size() const {
     return mFuncNum;
 }
 
+go::symbol::Snapshot go::symbol::SymbolTable::stats() const {
+#ifdef GO_SYMBOL_ENABLE_STATS
+    return mStats->snapshot();
+#else
+    return {};
+#endif
+}
+
+std::span<const uint8_t> go::symbol::SymbolTable::attributes() const {
+    std::call_once(*mClassified, [this]() {
+        classify();
+    });
+
+    return mAttributes;
+}
+
+int go::symbol::SymbolTable::capabilities() const {
+    return mCapabilities;
+}
+
+bool go::symbol::SymbolTable::hugePage() const {
+    if (mMemoryBuffer.index() != 1)
+        return false;
+
+    return std::get<memory::Buffer>(mMemoryBuffer).hugePage();
+}
+
 go::symbol::SymbolEntry go::symbol::SymbolTable::operator[](size_t index) const {
     return *(begin() + std::ptrdiff_t(index));
 }
@@ -115,22 +480,202 @@ const std::byte *go::symbol::SymbolTable::data() const {
     if (index == 0) {
         return std::get<std::shared_ptr<elf::ISection>>(mMemoryBuffer)->data();
     } else if (index == 1) {
-        return std::get<std::unique_ptr<std::byte[]>>(mMemoryBuffer).get();
+        return std::get<memory::Buffer>(mMemoryBuffer).data();
     }
 
     return std::get<const std::byte *>(mMemoryBuffer);
 }
 
-go::symbol::Symbol::Symbol(const go::symbol::SymbolTable *table, const std::byte *buffer)
-        : mTable(table), mBuffer(buffer) {
+std::ptrdiff_t go::symbol::SymbolTable::search(uint64_t address) const noexcept {
+    uint64_t target = address - mBase;
 
+    return dispatch(mConverter.endian(), mLayout.size, [&](auto functab) -> std::ptrdiff_t {
+        if (target < functab.word(mFuncTable) || target >= functab.word(mFuncTable + mFuncNum * 2 * functab.size))
+            return -1;
+
+        return std::ptrdiff_t(functab.search(mFuncTable, mFuncNum, target));
+    });
 }
 
-uint64_t go::symbol::Symbol::entry() const {
-    if (mTable->mVersion < VERSION118)
-        return mTable->mBase + mTable->mConverter(mBuffer, mTable->mPtrSize);
+const char *go::symbol::SymbolTable::file(uint32_t key) const {
+    if (mVersion == VERSION12)
+        return (const char *) mFuncData + read32(mLayout, mFileTable + key * 4);
+
+    return (const char *) mFileTable + key;
+}
+
+std::vector<std::pair<uint32_t, std::string_view>> go::symbol::SymbolTable::files() const {
+    std::vector<std::pair<uint32_t, std::string_view>> files;
+
+    if (!(mCapabilities & FileCapability) || !mFileTable)
+        return files;
+
+    if (mVersion == VERSION12) {
+        for (uint32_t i = 1; i < mFileNum; i++)
+            files.emplace_back(i, file(i));
+
+        return files;
+    }
+
+    const auto *ptr = (const char *) mFileTable;
+    const auto *end = (const char *) mPCTable;
+
+    while (ptr < end) {
+        size_t length = strnlen(ptr, end - ptr);
+
+        if (length)
+            files.emplace_back(ptr - (const char *) mFileTable, std::string_view{ptr, length});
+
+        ptr += length + 1;
+    }
+
+    return files;
+}
+
+size_t go::symbol::SymbolTable::wordSize() const {
+    return mLayout.size;
+}
+
+size_t go::symbol::SymbolTable::memorySize() const {
+    size_t index = mMemoryBuffer.index();
+
+    if (index == 0) {
+        return std::get<std::shared_ptr<elf::ISection>>(mMemoryBuffer)->size();
+    } else if (index == 1) {
+        return std::get<memory::Buffer>(mMemoryBuffer).size();
+    }
+
+    return 0;
+}
+
+std::span<const std::byte> go::symbol::SymbolTable::region(SymbolRegion region) const {
+    const std::byte *buffer = data();
+    size_t size = memorySize();
+
+    if (mVersion == VERSION12) {
+        if (region != FuncRegion)
+            return {};
+
+        return {buffer, size ? size : (mFuncNum + 1) * 2 * wordSize() + 8 + mPtrSize};
+    }
+
+    auto span = [](const std::byte *start, const std::byte *end) -> std::span<const std::byte> {
+        if (!start || !end || end < start)
+            return {};
+
+        return {start, end};
+    };
+
+    switch (region) {
+        case FuncNameRegion:
+            return span(mFuncNameTable, mFuncNameTable + mFuncNameSize);
+
+        case CuRegion:
+            return span(mCuTable, mFileTable);
+
+        case FileRegion:
+            return span(mFileTable, mPCTable);
+
+        case PCRegion:
+            return span(mPCTable, mFuncTable);
+
+        case FuncRegion:
+            return span(mFuncTable, size ? buffer + size : mFuncTable + (mFuncNum + 1) * 2 * wordSize());
+
+        default:
+            return {};
+    }
+}
+
+std::vector<go::symbol::SymbolRegion> go::symbol::SymbolTable::regions(int capabilities) const {
+    if (mVersion == VERSION12)
+        return {FuncRegion};
+
+    std::vector<SymbolRegion> regions;
+
+    if (capabilities & NameCapability) {
+        regions.push_back(FuncNameRegion);
+        regions.push_back(FuncRegion);
+    }
+
+    if (capabilities & PCValueCapability)
+        regions.push_back(PCRegion);
+
+    if (capabilities & FileCapability) {
+        regions.push_back(CuRegion);
+        regions.push_back(FileRegion);
+    }
+
+    return regions;
+}
+
+void go::symbol::SymbolTable::classify() const {
+    if (!mAttributes.empty())
+        return;
+
+    mAttributes.reserve(mFuncNum);
+
+    for (const auto &entry: *this)
+        mAttributes.push_back(entry.symbol().classify());
+}
+
+go::symbol::PCValue::PCValue(const std::byte *buffer, uint64_t entry, uint32_t quantum) noexcept
+        : mOrigin(buffer), mPosition(buffer), mDone(!buffer), mQuantum(quantum), mValue(-1), mStart(entry),
+          mEnd(entry) {
 
-    return mTable->mBase + mTable->mConverter(*(uint32_t *) mBuffer);
+}
+
+bool go::symbol::PCValue::next() noexcept {
+    if (mDone)
+        return false;
+
+    int64_t delta;
+    const std::byte *ptr = binary::varInt(mPosition, delta);
+
+    if (!ptr || (delta == 0 && mPosition != mOrigin)) {
+        mDone = true;
+        return false;
+    }
+
+    uint64_t step;
+    ptr = binary::uVarInt(ptr, step);
+
+    if (!ptr) {
+        mDone = true;
+        return false;
+    }
+
+    mValue += int(delta);
+    mStart = mEnd;
+    mEnd += step * mQuantum;
+    mPosition = ptr;
+
+    return true;
+}
+
+int go::symbol::PCValue::value() const noexcept {
+    return mValue;
+}
+
+uint64_t go::symbol::PCValue::start() const noexcept {
+    return mStart;
+}
+
+uint64_t go::symbol::PCValue::end() const noexcept {
+    return mEnd;
+}
+
+size_t go::symbol::PCValue::consumed() const noexcept {
+    return mPosition - mOrigin;
+}
+
+go::symbol::Symbol::Symbol(const go::symbol::SymbolTable *table, const std::byte *buffer, size_t index)
+        : mTable(table), mBuffer(buffer), mIndex(index) {
+
+}
+
+uint64_t go::symbol::Symbol::entry() const {
+    return mTable->mBase + readWord(mTable->mLayout, mBuffer);
 }
 
 const char *go::symbol::Symbol::name() const {
@@ -138,7 +683,7 @@ const char *go::symbol::Symbol::name() const {
 }
 
 int go::symbol::Symbol::frameSize(uint64_t pc) const {
-    uint32_t sp = field(4);
+    uint32_t sp = field(PCSPTable);
 
     if (sp == 0)
         return 0;
@@ -155,77 +700,258 @@ int go::symbol::Symbol::frameSize(uint64_t pc) const {
 }
 
 int go::symbol::Symbol::sourceLine(uint64_t pc) const {
-    return value(field(6), entry(), pc);
+    return value(field(PCLineTable), entry(), pc);
 }
 
 const char *go::symbol::Symbol::sourceFile(uint64_t pc) const {
-    int n = value(field(5), entry(), pc);
+    if (!(mTable->mCapabilities & FileCapability))
+        return "";
 
-    if (n < 0 || n > mTable->mFileNum)
+    std::optional<uint32_t> key = fileKey(value(field(PCFileTable), entry(), pc));
+
+    if (!key)
         return "";
 
-    if (mTable->mVersion == VERSION12) {
-        if (n == 0)
-            return "";
+    return mTable->file(*key);
+}
+
+void go::symbol::Symbol::frameSizes(std::span<const uint64_t> sortedPCs, std::span<int> out) const {
+    size_t n = std::min(sortedPCs.size(), out.size());
+    uint32_t sp = field(PCSPTable);
 
-        return (const char *) mTable->mFuncData + mTable->mConverter((mTable->mFileTable + n * 4), sizeof(int));
+    if (sp == 0) {
+        std::fill_n(out.begin(), n, 0);
+        return;
     }
 
-    uint32_t offset = mTable->mConverter((mTable->mCuTable + (field(8) + n) * 4), sizeof(uint32_t));
+    values(sp, entry(), sortedPCs, out);
 
-    if (!offset)
-        return "";
+    std::transform(out.begin(), out.begin() + std::ptrdiff_t(n), out.begin(), [this](int x) {
+        if (x == -1 || (x & (mTable->mPtrSize - 1)))
+            return 0;
+
+        return x;
+    });
+}
+
+void go::symbol::Symbol::sourceLines(std::span<const uint64_t> sortedPCs, std::span<int> out) const {
+    values(field(PCLineTable), entry(), sortedPCs, out);
+}
+
+void go::symbol::Symbol::sourceFiles(std::span<const uint64_t> sortedPCs, std::span<const char *> out) const {
+    size_t n = std::min(sortedPCs.size(), out.size());
+
+    if (!(mTable->mCapabilities & FileCapability)) {
+        std::fill_n(out.begin(), n, "");
+        return;
+    }
+
+    std::vector<int> keys(n);
+    values(field(PCFileTable), entry(), sortedPCs, keys);
+
+    for (size_t i = 0; i < n; i++) {
+        std::optional<uint32_t> key = fileKey(keys[i]);
+        out[i] = key ? mTable->file(*key) : "";
+    }
+}
+
+go::symbol::PCValue go::symbol::Symbol::pcValue(PCTable table) const {
+    if (!(mTable->mCapabilities & PCValueCapability))
+        return {nullptr, entry(), mTable->mQuantum};
 
-    return (const char *) mTable->mFileTable + offset;
+    return {mTable->mPCTable + field(table), entry(), mTable->mQuantum};
+}
+
+void go::symbol::Symbol::lines(
+        const std::function<void(uint64_t, uint64_t, std::optional<uint32_t>, int)> &callback
+) const {
+    PCValue lines = pcValue(PCLineTable);
+    PCValue files = pcValue(PCFileTable);
+
+    bool hasLine = lines.next();
+    bool hasFile = files.next();
+
+    uint64_t pc = entry();
+    uint64_t start = pc;
+
+    int line = -1;
+    std::optional<uint32_t> file;
+
+    while (hasLine && hasFile) {
+        std::optional<uint32_t> key = fileKey(files.value());
+
+        if (lines.value() != line || key != file) {
+            if (line >= 0 && file && pc > start)
+                callback(start, pc, file, line);
+
+            start = pc;
+            line = lines.value();
+            file = key;
+        }
+
+        pc = std::min(lines.end(), files.end());
+
+        if (lines.end() <= pc)
+            hasLine = lines.next();
+
+        if (files.end() <= pc)
+            hasFile = files.next();
+    }
+
+    if (line >= 0 && file && pc > start)
+        callback(start, pc, file, line);
+}
+
+int go::symbol::Symbol::attributes() const {
+    std::span<const uint8_t> attributes = mTable->attributes();
+
+    if (mIndex >= attributes.size())
+        return classify();
+
+    return attributes[mIndex];
 }
 
 bool go::symbol::Symbol::isStackTop() const {
-    return std::any_of(STACK_TOP_FUNCTION.begin(), STACK_TOP_FUNCTION.end(), [name = name()](const auto &func) {
-        return strcmp(func, name) == 0;
-    });
+    return attributes() & StackTopAttribute;
 }
 
 uint32_t go::symbol::Symbol::field(int n) const {
-    return mTable->mConverter(
-            *(uint32_t *) (mBuffer + (mTable->mVersion >= VERSION118 ? 4 : mTable->mPtrSize) + (n - 1) * 4)
-    );
+    return readField(mTable->mLayout, mBuffer, n);
 }
 
-int go::symbol::Symbol::value(uint32_t offset, uint64_t entry, uint64_t target) const {
-    const std::byte *buffer = mTable->mPCTable + offset;
+uint8_t go::symbol::Symbol::flag() const {
+    if (mTable->mVersion == VERSION12 || mTable->mVersion == VERSION116)
+        return 0;
 
-    int value = -1;
-    uint64_t pc = entry;
+    int n = mTable->mVersion == VERSION118 ? 9 : 10;
+    return std::to_integer<uint8_t>(mBuffer[mTable->wordSize() + (n - 1) * sizeof(uint32_t) + 1]);
+}
 
-    while (true) {
-        std::optional<std::pair<int64_t, int>> result = binary::varInt(buffer);
+uint8_t go::symbol::Symbol::classify() const {
+    std::string_view name = this->name();
 
-        if (!result)
-            return -1;
+    uint8_t flag = this->flag();
+    uint8_t attributes = 0;
 
-        if (result->first == 0 && pc != entry)
-            return -1;
+    if ((flag & TOP_FRAME_FLAG) || std::find(STACK_TOP_FUNCTION.begin(), STACK_TOP_FUNCTION.end(), name) != STACK_TOP_FUNCTION.end())
+        attributes |= StackTopAttribute;
 
-        value += int(result->first);
-        buffer += result->second;
+    if (std::any_of(RUNTIME_PACKAGE_PREFIX.begin(), RUNTIME_PACKAGE_PREFIX.end(), [=](const auto &prefix) {
+        return name.starts_with(prefix);
+    }))
+        attributes |= RuntimeAttribute;
 
-        result = binary::uVarInt(buffer);
+    if (name.ends_with(WRAPPER_FUNCTION_SUFFIX))
+        attributes |= WrapperAttribute;
 
-        if (!result)
-            return -1;
+    if (flag & ASM_FLAG)
+        attributes |= AsmAttribute;
 
-        pc += result->first * mTable->mQuantum;
-        buffer += result->second;
+    bool flagged = mTable->mVersion >= VERSION120;
 
-        if (target < pc)
+    if ((attributes & WrapperAttribute) && (flagged || (attributes & AsmAttribute)))
+        return attributes;
+
+    PCValue files = pcValue(PCFileTable);
+    std::optional<uint32_t> key = files.next() ? fileKey(files.value()) : std::nullopt;
+
+    if (!key)
+        return attributes;
+
+    std::string_view file = mTable->file(*key);
+
+    if (file == AUTOGENERATED_FILE)
+        attributes |= WrapperAttribute;
+    else if (!flagged && file.ends_with(ASM_FILE_SUFFIX))
+        attributes |= AsmAttribute;
+
+    return attributes;
+}
+
+std::optional<uint32_t> go::symbol::Symbol::fileKey(int n) const {
+    if (!(mTable->mCapabilities & FileCapability))
+        return std::nullopt;
+
+    if (n < 0 || n > mTable->mFileNum)
+        return std::nullopt;
+
+    if (mTable->mVersion == VERSION12) {
+        if (n == 0)
+            return std::nullopt;
+
+        return n;
+    }
+
+    uint32_t offset = read32(mTable->mLayout, mTable->mCuTable + (field(8) + n) * 4);
+
+    if (!offset)
+        return std::nullopt;
+
+    return offset;
+}
+
+int go::symbol::Symbol::value(uint32_t offset, uint64_t entry, uint64_t target) const {
+    if (!(mTable->mCapabilities & PCValueCapability))
+        return -1;
+
+    GO_SYMBOL_STATS_TIMER(mTable->mStats.get(), ValueOperation);
+
+    int value = -1;
+    PCValue pcValue(mTable->mPCTable + offset, entry, mTable->mQuantum);
+
+    [[maybe_unused]] size_t count = 0;
+
+    while (pcValue.next()) {
+        count += 2;
+
+        if (target < pcValue.end()) {
+            value = pcValue.value();
             break;
+        }
     }
 
+    GO_SYMBOL_STATS_ADD(mTable->mStats.get(), PCValueByteCounter, pcValue.consumed());
+    GO_SYMBOL_STATS_ADD(mTable->mStats.get(), VarIntCounter, count);
+    GO_SYMBOL_PROBE4(value, entry, target, value, pcValue.consumed());
+
     return value;
 }
 
-go::symbol::SymbolEntry::SymbolEntry(const go::symbol::SymbolTable *table, uint64_t entry, uint64_t offset)
-        : mTable(table), mEntry(entry), mOffset(offset) {
+void go::symbol::Symbol::values(
+        uint32_t offset,
+        uint64_t entry,
+        std::span<const uint64_t> targets,
+        std::span<int> out
+) const {
+    size_t n = std::min(targets.size(), out.size());
+    size_t i = 0;
+
+    if (mTable->mCapabilities & PCValueCapability) {
+        GO_SYMBOL_STATS_TIMER(mTable->mStats.get(), ValueOperation);
+
+        PCValue pcValue(mTable->mPCTable + offset, entry, mTable->mQuantum);
+        [[maybe_unused]] size_t count = 0;
+
+        while (i < n && pcValue.next()) {
+            count += 2;
+
+            while (i < n && targets[i] < pcValue.end())
+                out[i++] = pcValue.value();
+        }
+
+        GO_SYMBOL_STATS_ADD(mTable->mStats.get(), PCValueByteCounter, pcValue.consumed());
+        GO_SYMBOL_STATS_ADD(mTable->mStats.get(), VarIntCounter, count);
+    }
+
+    std::fill(out.begin() + std::ptrdiff_t(i), out.begin() + std::ptrdiff_t(n), -1);
+}
+
+go::symbol::SymbolEntry::SymbolEntry(
+        const go::symbol::SymbolTable *table,
+        uint64_t entry,
+        uint64_t offset,
+        size_t index
+) : mTable(table), mEntry(entry), mOffset(offset), mIndex(index) {
 
 }
 
@@ -234,19 +960,20 @@ uint64_t go::symbol::SymbolEntry::entry() const {
 }
 
 go::symbol::Symbol go::symbol::SymbolEntry::symbol() const {
-    return {mTable, mTable->mFuncData + mOffset};
+    return {mTable, mTable->mFuncData + mOffset, mIndex};
 }
 
 go::symbol::SymbolIterator::SymbolIterator(const go::symbol::SymbolTable *table, const std::byte *buffer)
-        : mTable(table), mBuffer(buffer), mSize(table->mVersion >= VERSION118 ? 4 : table->mPtrSize) {
+        : mTable(table), mBuffer(buffer), mSize(table->wordSize()) {
 
 }
 
 go::symbol::SymbolEntry go::symbol::SymbolIterator::operator*() {
     return {
             mTable,
-            mTable->mBase + mTable->mConverter(mBuffer, mSize),
-            mTable->mConverter(mBuffer + mSize, mSize)
+            mTable->mBase + readWord(mTable->mLayout, mBuffer),
+            readWord(mTable->mLayout, mBuffer + mSize),
+            size_t(mBuffer - mTable->mFuncTable) / (2 * mSize)
     };
 }
 
@@ -292,15 +1019,36 @@ go::symbol::seek::SymbolTable::SymbolTable(
         std::streamoff offset,
         uint64_t address,
         uint64_t base
-) : mVersion(version), mConverter(converter), mStream(std::move(stream)), mOffset(offset), mAddress(address),
-    mBase(base) {
-    std::byte buffer[128];
+) : SymbolTable(version, converter, std::move(stream), nullptr, offset, address, base) {
 
-    mStream.seekg(mOffset, std::ifstream::beg);
-    mStream.read((char *) buffer, sizeof(buffer));
+}
+
+go::symbol::seek::SymbolTable::SymbolTable(
+        SymbolVersion version,
+        endian::Converter converter,
+        std::shared_ptr<CompressedSection> section,
+        uint64_t address,
+        uint64_t base
+) : SymbolTable(version, converter, std::ifstream(), std::move(section), 0, address, base) {
+
+}
+
+go::symbol::seek::SymbolTable::SymbolTable(
+        SymbolVersion version,
+        endian::Converter converter,
+        std::ifstream stream,
+        std::shared_ptr<CompressedSection> section,
+        std::streamoff offset,
+        uint64_t address,
+        uint64_t base
+) : mVersion(version), mConverter(converter), mStream(std::move(stream)), mSection(std::move(section)),
+    mOffset(offset), mAddress(address), mBase(base) {
+    std::byte buffer[128];
+    read(mAddress, buffer, sizeof(buffer));
 
     mQuantum = std::to_integer<uint32_t>(buffer[6]);
     mPtrSize = std::to_integer<uint32_t>(buffer[7]);
+    mLayout = layout(mVersion, mConverter.endian(), mPtrSize);
 
     switch (mVersion) {
         case VERSION12: {
@@ -313,15 +1061,12 @@ go::symbol::seek::SymbolTable::SymbolTable(
             uint32_t funcTableSize = mFuncNum * 2 * mPtrSize + mPtrSize;
             uint32_t fileOffset = 0;
 
-            mStream.seekg(mOffset + (std::streamoff) (mFuncTable + funcTableSize - mAddress), std::ifstream::beg);
-            mStream.read((char *) &fileOffset, sizeof(uint32_t));
+            read(mFuncTable + funcTableSize, &fileOffset, sizeof(uint32_t));
             fileOffset = mConverter(fileOffset);
 
             mFileTable = mAddress + fileOffset;
 
-            mStream.seekg(mOffset + (std::streamoff) (mFileTable - mAddress), std::ifstream::beg);
-            mStream.read((char *) &mFileNum, sizeof(uint32_t));
-
+            read(mFileTable, &mFileNum, sizeof(uint32_t));
             mFileNum = mConverter(mFileNum);
 
             break;
@@ -359,80 +1104,278 @@ go::symbol::seek::SymbolTable::SymbolTable(
         }
     }
 
-    uint64_t size = (mFuncNum + 1) * 2 * (mVersion >= VERSION118 ? 4 : mPtrSize);
-    mFuncTableBuffer = std::make_unique<std::byte[]>(size);
+    mValid = pack();
+}
+
+bool go::symbol::seek::SymbolTable::pack() {
+    size_t count = mFuncNum + 1;
+    size_t stride = 2 * wordSize();
+
+    std::byte buffer[FUNC_TABLE_BLOCK_SIZE * 16];
+    std::array<uint64_t, FUNC_TABLE_BLOCK_SIZE> pcs = {};
+    std::array<uint64_t, FUNC_TABLE_BLOCK_SIZE> offsets = {};
+
+    uint64_t position = 0;
+    mBlocks.reserve((count + FUNC_TABLE_BLOCK_SIZE - 1) / FUNC_TABLE_BLOCK_SIZE);
+
+    for (size_t start = 0; start < count; start += FUNC_TABLE_BLOCK_SIZE) {
+        size_t n = std::min<size_t>(FUNC_TABLE_BLOCK_SIZE, count - start);
+
+        if (read(mFuncTable + start * stride, buffer, n * stride) != n * stride) {
+            LOG_ERROR("read function table failed");
+            mFuncNum = 0;
+            mBlocks.clear();
+            mPacked.clear();
+            return false;
+        }
+
+        dispatch(mConverter.endian(), mLayout.size, [&](auto functab) {
+            for (size_t i = 0; i < n; i++) {
+                pcs[i] = functab.word(buffer + i * stride);
+                offsets[i] = functab.word(buffer + i * stride + functab.size);
+            }
+        });
+
+        if (start == 0)
+            mEntryBase = pcs[0];
+
+        PackedField pc = packField({pcs.data(), n});
+        PackedField offset = packField({offsets.data(), n});
+
+        if (pc.bits > 32 || offset.bits > 32) {
+            LOG_ERROR("function table block too sparse");
+            mFuncNum = 0;
+            mBlocks.clear();
+            mPacked.clear();
+            return false;
+        }
+
+        mBlocks.push_back(
+                {
+                        uint32_t(pcs[0] - mEntryBase),
+                        uint32_t(offsets[0]),
+                        int32_t(pc.stride),
+                        int32_t(offset.stride),
+                        uint32_t(position),
+                        pc.bits,
+                        pc.shift,
+                        offset.bits,
+                        offset.shift
+                }
+        );
+
+        for (size_t i = 0; i < n; i++) {
+            appendBits(mPacked, position, (pcs[i] - pcs[0] - uint64_t(pc.stride * int64_t(i))) >> pc.shift, pc.bits);
+            appendBits(
+                    mPacked,
+                    position,
+                    (offsets[i] - offsets[0] - uint64_t(offset.stride * int64_t(i))) >> offset.shift,
+                    offset.bits
+            );
+        }
+    }
+
+    mPacked.resize(mPacked.size() + sizeof(uint64_t));
+    mPacked.shrink_to_fit();
 
-    mStream.seekg(mOffset + (std::streamoff) (mFuncTable - mAddress), std::ifstream::beg);
-    mStream.read((char *) mFuncTableBuffer.get(), (std::streamsize) size);
+    return true;
+}
+
+size_t go::symbol::seek::SymbolTable::wordSize() const {
+    return mLayout.size;
+}
+
+uint64_t go::symbol::seek::SymbolTable::pc(size_t index) const {
+    const FuncTableBlock &block = mBlocks[index / FUNC_TABLE_BLOCK_SIZE];
+    size_t i = index % FUNC_TABLE_BLOCK_SIZE;
+
+    uint64_t residual = extractBits(
+            mPacked.data(),
+            block.position + i * (block.pcBits + block.offsetBits),
+            block.pcBits
+    );
+
+    return mEntryBase + block.pc + uint64_t(int64_t(block.pcStride) * int64_t(i)) + (residual << block.pcShift);
+}
+
+uint64_t go::symbol::seek::SymbolTable::funcOffset(size_t index) const {
+    const FuncTableBlock &block = mBlocks[index / FUNC_TABLE_BLOCK_SIZE];
+    size_t i = index % FUNC_TABLE_BLOCK_SIZE;
+
+    uint64_t residual = extractBits(
+            mPacked.data(),
+            block.position + i * (block.pcBits + block.offsetBits) + block.pcBits,
+            block.offsetBits
+    );
+
+    return block.offset + uint64_t(int64_t(block.offsetStride) * int64_t(i)) + (residual << block.offsetShift);
 }
 
 go::symbol::seek::SymbolIterator go::symbol::seek::SymbolTable::find(uint64_t address) {
-    if (address < operator[](0).entry() || address >= operator[](mFuncNum).entry())
+    GO_SYMBOL_STATS_TIMER(mStats.get(), FindOperation);
+    GO_SYMBOL_STATS_ADD(mStats.get(), LookupCounter, 1);
+
+    uint64_t target = address - mBase;
+
+    if (mBlocks.empty() || target < pc(0) || target >= pc(mFuncNum)) {
+        GO_SYMBOL_STATS_ADD(mStats.get(), MissCounter, 1);
+        GO_SYMBOL_PROBE2(seek_find, address, -1);
         return end();
+    }
 
-    return std::upper_bound(begin(), end() + 1, address, [](uint64_t value, const auto &entry) {
-        return value < entry.entry();
-    }) - 1;
+    auto block = std::prev(std::upper_bound(
+            mBlocks.begin(),
+            mBlocks.end(),
+            target - mEntryBase,
+            [](uint64_t value, const auto &block) {
+                return value < block.pc;
+            }
+    ));
+
+    size_t low = (block - mBlocks.begin()) * FUNC_TABLE_BLOCK_SIZE;
+    size_t high = std::min<size_t>(low + FUNC_TABLE_BLOCK_SIZE, mFuncNum);
+
+    while (high - low > 1) {
+        size_t middle = low + (high - low) / 2;
+
+        if (pc(middle) <= target)
+            low = middle;
+        else
+            high = middle;
+    }
+
+    size_t index = low;
+    GO_SYMBOL_PROBE2(seek_find, address, index);
+
+    return begin() + std::ptrdiff_t(index);
 }
 
 go::symbol::seek::SymbolIterator go::symbol::seek::SymbolTable::find(std::string_view name) {
-    return std::find_if(begin(), end(), [=](const auto &entry) {
+    GO_SYMBOL_STATS_ADD(mStats.get(), LookupCounter, 1);
+
+    auto it = std::find_if(begin(), end(), [=](const auto &entry) {
         return name == entry.symbol().name();
     });
+
+    if (it == end())
+        GO_SYMBOL_STATS_ADD(mStats.get(), MissCounter, 1);
+
+    return it;
+}
+
+bool go::symbol::seek::SymbolTable::valid() const {
+    return mValid;
 }
 
 size_t go::symbol::seek::SymbolTable::size() const {
     return mFuncNum;
 }
 
+go::symbol::Snapshot go::symbol::seek::SymbolTable::stats() const {
+#ifdef GO_SYMBOL_ENABLE_STATS
+    return mStats->snapshot();
+#else
+    return {};
+#endif
+}
+
+go::memory::Usage go::symbol::seek::SymbolTable::memoryUsage() const {
+    memory::Usage usage = {mBlocks.capacity() * sizeof(FuncTableBlock) + mPacked.capacity(), 0, 0};
+
+    if (mSection) {
+        memory::Usage section = mSection->memoryUsage();
+
+        usage.heap += section.heap;
+        usage.mapped += section.mapped;
+        usage.resident += section.resident;
+    }
+
+    return usage;
+}
+
 go::symbol::seek::SymbolEntry go::symbol::seek::SymbolTable::operator[](size_t index) {
     return *(begin() + std::ptrdiff_t(index));
 }
 
 go::symbol::seek::SymbolIterator go::symbol::seek::SymbolTable::begin() {
-    return {this, mFuncTableBuffer.get()};
+    return {this, 0};
 }
 
 go::symbol::seek::SymbolIterator go::symbol::seek::SymbolTable::end() {
     return begin() + mFuncNum;
 }
 
-go::symbol::seek::Symbol::Symbol(go::symbol::seek::SymbolTable *table, uint64_t address)
-        : mTable(table), mAddress(address) {
+void go::symbol::seek::SymbolTable::seek(uint64_t address) {
+    if (mSection) {
+        GO_SYMBOL_STATS_ADD(mStats.get(), SeekCounter, 1);
+        mSection->seek(address - mAddress);
+        return;
+    }
+
+    mStream.clear();
 
+    std::streamoff offset = mOffset + (std::streamoff) (address - mAddress);
+
+    if (mStream.tellg() == offset) {
+        GO_SYMBOL_STATS_ADD(mStats.get(), CacheHitCounter, 1);
+        return;
+    }
+
+    GO_SYMBOL_STATS_ADD(mStats.get(), SeekCounter, 1);
+    mStream.seekg(offset, std::ifstream::beg);
 }
 
-uint64_t go::symbol::seek::Symbol::entry() const {
-    if (mTable->mVersion < VERSION118) {
-        std::byte buffer[8] = {};
+size_t go::symbol::seek::SymbolTable::read(uint64_t address, void *buffer, size_t length) {
+    seek(address);
+    return read(buffer, length);
+}
 
-        mTable->mStream.seekg(mTable->mOffset + (std::streamoff) (mAddress - mTable->mAddress), std::ifstream::beg);
-        mTable->mStream.read((char *) &buffer, mTable->mPtrSize);
+size_t go::symbol::seek::SymbolTable::read(void *buffer, size_t length) {
+    GO_SYMBOL_STATS_TIMER(mStats.get(), ReadOperation);
+    GO_SYMBOL_STATS_ADD(mStats.get(), ReadCounter, 1);
 
-        if (mTable->mPtrSize == 4)
-            return mTable->mBase + mTable->mConverter(*(uint32_t *) buffer);
+    if (mSection) {
+        size_t n = mSection->read(buffer, length);
+        GO_SYMBOL_PROBE2(seek_read, length, n);
 
-        return mTable->mBase + mTable->mConverter(*(uint64_t *) buffer);
+        return n;
     }
 
-    uint32_t entry;
+    mStream.read((char *) buffer, (std::streamsize) length);
+    GO_SYMBOL_PROBE2(seek_read, length, mStream.gcount());
+
+    return mStream.gcount();
+}
+
+std::string go::symbol::seek::SymbolTable::readString(uint64_t address) {
+    GO_SYMBOL_STATS_TIMER(mStats.get(), ReadOperation);
+    GO_SYMBOL_STATS_ADD(mStats.get(), ReadCounter, 1);
 
-    mTable->mStream.seekg(mTable->mOffset + (std::streamoff) (mAddress - mTable->mAddress), std::ifstream::beg);
-    mTable->mStream.read((char *) &entry, sizeof(uint32_t));
+    seek(address);
 
-    return mTable->mBase + mTable->mConverter(entry);
+    if (mSection)
+        return mSection->readString();
+
+    std::string str;
+    std::getline(mStream, str, '\0');
+
+    return str;
 }
 
-std::string go::symbol::seek::Symbol::name() const {
-    mTable->mStream.seekg(
-            mTable->mOffset + (std::streamoff) (mTable->mFuncNameTable + field(1) - mTable->mAddress),
-            std::ifstream::beg
-    );
+go::symbol::seek::Symbol::Symbol(go::symbol::seek::SymbolTable *table, uint64_t address)
+        : mTable(table), mAddress(address) {
+
+}
 
-    std::string name;
-    std::getline(mTable->mStream, name, '\0');
+uint64_t go::symbol::seek::Symbol::entry() const {
+    std::byte buffer[8] = {};
+    mTable->read(mAddress, buffer, mTable->wordSize());
 
-    return name;
+    return mTable->mBase + readWord(mTable->mLayout, buffer);
+}
+
+std::string go::symbol::seek::Symbol::name() const {
+    return mTable->readString(mTable->mFuncNameTable + field(1));
 }
 
 int go::symbol::seek::Symbol::frameSize(uint64_t pc) const {
@@ -457,58 +1400,40 @@ int go::symbol::seek::Symbol::sourceLine(uint64_t pc) const {
 }
 
 std::string go::symbol::seek::Symbol::sourceFile(uint64_t pc) const {
-    int n = value(field(5), entry(), pc);
-
-    if (n < 0 || n > mTable->mFileNum)
-        return "";
-
-    if (mTable->mVersion == VERSION12) {
-        if (n == 0)
-            return "";
-
-        int offset;
-
-        mTable->mStream.seekg(
-                mTable->mOffset + (std::streamoff) (mTable->mFileTable + n * 4 - mTable->mAddress),
-                std::ifstream::beg
-        );
-
-        mTable->mStream.read((char *) &offset, sizeof(int));
-        offset = mTable->mConverter(offset);
-
-        mTable->mStream.seekg(
-                mTable->mOffset + (std::streamoff) (mTable->mFuncData + offset - mTable->mAddress),
-                std::ifstream::beg
-        );
+    return file(value(field(5), entry(), pc));
+}
 
-        std::string name;
-        std::getline(mTable->mStream, name, '\0');
+void go::symbol::seek::Symbol::frameSizes(std::span<const uint64_t> sortedPCs, std::span<int> out) const {
+    size_t n = std::min(sortedPCs.size(), out.size());
+    uint32_t sp = field(4);
 
-        return name;
+    if (sp == 0) {
+        std::fill_n(out.begin(), n, 0);
+        return;
     }
 
-    uint32_t offset;
+    values(sp, entry(), sortedPCs, out);
 
-    mTable->mStream.seekg(
-            mTable->mOffset + (std::streamoff) (mTable->mCuTable + (field(8) + n) * 4 - mTable->mAddress),
-            std::ifstream::beg
-    );
+    std::transform(out.begin(), out.begin() + std::ptrdiff_t(n), out.begin(), [this](int x) {
+        if (x == -1 || (x & (mTable->mPtrSize - 1)))
+            return 0;
 
-    mTable->mStream.read((char *) &offset, sizeof(uint32_t));
-    offset = mTable->mConverter(offset);
+        return x;
+    });
+}
 
-    if (!offset)
-        return "";
+void go::symbol::seek::Symbol::sourceLines(std::span<const uint64_t> sortedPCs, std::span<int> out) const {
+    values(field(6), entry(), sortedPCs, out);
+}
 
-    mTable->mStream.seekg(
-            mTable->mOffset + (std::streamoff) (mTable->mFileTable + offset - mTable->mAddress),
-            std::ifstream::beg
-    );
+void go::symbol::seek::Symbol::sourceFiles(std::span<const uint64_t> sortedPCs, std::span<std::string> out) const {
+    size_t n = std::min(sortedPCs.size(), out.size());
 
-    std::string name;
-    std::getline(mTable->mStream, name, '\0');
+    std::vector<int> keys(n);
+    values(field(5), entry(), sortedPCs, keys);
 
-    return name;
+    for (size_t i = 0; i < n; i++)
+        out[i] = file(keys[i]);
 }
 
 bool go::symbol::seek::Symbol::isStackTop() const {
@@ -518,52 +1443,73 @@ bool go::symbol::seek::Symbol::isStackTop() const {
 }
 
 uint32_t go::symbol::seek::Symbol::field(int n) const {
-    mTable->mStream.seekg(
-            mTable->mOffset +
-            (std::streamoff) (mAddress + (mTable->mVersion >= VERSION118 ? 4 : mTable->mPtrSize) + (n - 1) * 4 -
-                              mTable->mAddress),
-            std::ifstream::beg
-    );
+    std::byte buffer[4] = {};
+    mTable->read(mAddress + mTable->wordSize() + (n - 1) * 4, buffer, sizeof(buffer));
+
+    return read32(mTable->mLayout, buffer);
+}
+
+std::string go::symbol::seek::Symbol::file(int n) const {
+    if (n < 0 || n > mTable->mFileNum)
+        return "";
+
+    if (mTable->mVersion == VERSION12) {
+        if (n == 0)
+            return "";
+
+        std::byte buffer[4] = {};
+        mTable->read(mTable->mFileTable + n * 4, buffer, sizeof(buffer));
+
+        return mTable->readString(mTable->mFuncData + read32(mTable->mLayout, buffer));
+    }
+
+    std::byte buffer[4] = {};
+    mTable->read(mTable->mCuTable + (field(8) + n) * 4, buffer, sizeof(buffer));
 
-    uint32_t value;
-    mTable->mStream.read((char *) &value, sizeof(uint32_t));
+    uint32_t offset = read32(mTable->mLayout, buffer);
 
-    return mTable->mConverter(value);
+    if (!offset)
+        return "";
+
+    return mTable->readString(mTable->mFileTable + offset);
 }
 
 int go::symbol::seek::Symbol::value(uint32_t offset, uint64_t entry, uint64_t target) const {
-    mTable->mStream.seekg(
-            mTable->mOffset + (std::streamoff) (mTable->mPCTable + offset - mTable->mAddress),
-            std::ifstream::beg
-    );
+    GO_SYMBOL_STATS_TIMER(mTable->mStats.get(), ValueOperation);
 
     int length = 0;
     std::byte buffer[1024];
 
-    mTable->mStream.read((char *) buffer, sizeof(buffer));
+    mTable->read(mTable->mPCTable + offset, buffer, sizeof(buffer));
 
     int value = -1;
     uint64_t pc = entry;
 
+    size_t consumed = 0;
+    [[maybe_unused]] size_t count = 0;
+
     while (true) {
-        std::optional<std::pair<int64_t, int>> result = binary::varInt(buffer + length);
+        int64_t delta;
+        const std::byte *ptr = binary::varInt(buffer + length, delta);
 
-        if (!result)
+        if (!ptr)
             return -1;
 
-        if (result->first == 0 && pc != entry)
+        if (delta == 0 && pc != entry)
             return -1;
 
-        value += int(result->first);
-        length += result->second;
+        value += int(delta);
 
-        result = binary::uVarInt(buffer + length);
+        uint64_t step;
+        ptr = binary::uVarInt(ptr, step);
 
-        if (!result)
+        if (!ptr)
             return -1;
 
-        pc += result->first * mTable->mQuantum;
-        length += result->second;
+        pc += step * mTable->mQuantum;
+        consumed += ptr - (buffer + length);
+        length = int(ptr - buffer);
+        count += 2;
 
         if (target < pc)
             break;
@@ -572,14 +1518,81 @@ int go::symbol::seek::Symbol::value(uint32_t offset, uint64_t entry, uint64_t ta
             continue;
 
         memcpy(buffer, buffer + length, sizeof(buffer) - length);
-        mTable->mStream.read((char *) buffer + sizeof(buffer) - length, length);
+        mTable->read(buffer + sizeof(buffer) - length, length);
 
         length = 0;
     }
 
+    GO_SYMBOL_STATS_ADD(mTable->mStats.get(), PCValueByteCounter, consumed);
+    GO_SYMBOL_STATS_ADD(mTable->mStats.get(), VarIntCounter, count);
+    GO_SYMBOL_PROBE4(seek_value, entry, target, value, consumed);
+
     return value;
 }
 
+void go::symbol::seek::Symbol::values(
+        uint32_t offset,
+        uint64_t entry,
+        std::span<const uint64_t> targets,
+        std::span<int> out
+) const {
+    GO_SYMBOL_STATS_TIMER(mTable->mStats.get(), ValueOperation);
+
+    size_t n = std::min(targets.size(), out.size());
+    size_t i = 0;
+
+    int length = 0;
+    std::byte buffer[1024];
+
+    mTable->read(mTable->mPCTable + offset, buffer, sizeof(buffer));
+
+    int value = -1;
+    uint64_t pc = entry;
+
+    size_t consumed = 0;
+    [[maybe_unused]] size_t count = 0;
+
+    while (i < n) {
+        int64_t delta;
+        const std::byte *ptr = binary::varInt(buffer + length, delta);
+
+        if (!ptr)
+            break;
+
+        if (delta == 0 && pc != entry)
+            break;
+
+        value += int(delta);
+
+        uint64_t step;
+        ptr = binary::uVarInt(ptr, step);
+
+        if (!ptr)
+            break;
+
+        pc += step * mTable->mQuantum;
+        consumed += ptr - (buffer + length);
+        length = int(ptr - buffer);
+        count += 2;
+
+        while (i < n && targets[i] < pc)
+            out[i++] = value;
+
+        if (sizeof(buffer) - length >= 2 * MAX_VAR_INT_LENGTH)
+            continue;
+
+        memcpy(buffer, buffer + length, sizeof(buffer) - length);
+        mTable->read(buffer + sizeof(buffer) - length, length);
+
+        length = 0;
+    }
+
+    std::fill(out.begin() + std::ptrdiff_t(i), out.begin() + std::ptrdiff_t(n), -1);
+
+    GO_SYMBOL_STATS_ADD(mTable->mStats.get(), PCValueByteCounter, consumed);
+    GO_SYMBOL_STATS_ADD(mTable->mStats.get(), VarIntCounter, count);
+}
+
 go::symbol::seek::SymbolEntry::SymbolEntry(go::symbol::seek::SymbolTable *table, uint64_t entry, uint64_t offset)
         : mTable(table), mEntry(entry), mOffset(offset) {
 
@@ -593,44 +1606,44 @@ go::symbol::seek::Symbol go::symbol::seek::SymbolEntry::symbol() const {
     return {mTable, mTable->mFuncData + mOffset};
 }
 
-go::symbol::seek::SymbolIterator::SymbolIterator(go::symbol::seek::SymbolTable *table, const std::byte *buffer)
-        : mTable(table), mBuffer(buffer), mSize(table->mVersion >= VERSION118 ? 4 : table->mPtrSize) {
+go::symbol::seek::SymbolIterator::SymbolIterator(go::symbol::seek::SymbolTable *table, size_t index)
+        : mTable(table), mIndex(index) {
 
 }
 
 go::symbol::seek::SymbolEntry go::symbol::seek::SymbolIterator::operator*() {
     return {
             mTable,
-            mTable->mBase + mTable->mConverter(mBuffer, mSize),
-            mTable->mConverter(mBuffer + mSize, mSize)
+            mTable->mBase + mTable->pc(mIndex),
+            mTable->funcOffset(mIndex)
     };
 }
 
 go::symbol::seek::SymbolIterator &go::symbol::seek::SymbolIterator::operator--() {
-    mBuffer -= 2 * mSize;
+    mIndex--;
     return *this;
 }
 
 go::symbol::seek::SymbolIterator &go::symbol::seek::SymbolIterator::operator++() {
-    mBuffer += 2 * mSize;
+    mIndex++;
     return *this;
 }
 
 go::symbol::seek::SymbolIterator &go::symbol::seek::SymbolIterator::operator+=(std::ptrdiff_t offset) {
-    mBuffer += offset * 2 * mSize;
+    mIndex += offset;
     return *this;
 }
 
 go::symbol::seek::SymbolIterator go::symbol::seek::SymbolIterator::operator-(std::ptrdiff_t offset) {
-    return {mTable, mBuffer - offset * 2 * mSize};
+    return {mTable, mIndex - offset};
 }
 
 go::symbol::seek::SymbolIterator go::symbol::seek::SymbolIterator::operator+(std::ptrdiff_t offset) {
-    return {mTable, mBuffer + offset * 2 * mSize};
+    return {mTable, mIndex + offset};
 }
 
 bool go::symbol::seek::SymbolIterator::operator==(const go::symbol::seek::SymbolIterator &rhs) {
-    return mBuffer == rhs.mBuffer;
+    return mIndex == rhs.mIndex;
 }
 
 bool go::symbol::seek::SymbolIterator::operator!=(const go::symbol::seek::SymbolIterator &rhs) {
@@ -638,5 +1651,5 @@ bool go::symbol::seek::SymbolIterator::operator!=(const go::symbol::seek::Symbol
 }
 
 std::ptrdiff_t go::symbol::seek::SymbolIterator::operator-(const go::symbol::seek::SymbolIterator &rhs) {
-    return (mBuffer - rhs.mBuffer) / std::ptrdiff_t(2 * mSize);
+    return std::ptrdiff_t(mIndex) - std::ptrdiff_t(rhs.mIndex);
 }
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include <go/symbol/symbolizer.h>
+
+go::symbol::Symbolizer::Symbolizer(SymbolTable symbols, std::optional<NativeSymbolTable> native)
+        : mSymbols(std::move(symbols)), mNative(std::move(native)) {
+
+}
+
+std::optional<go::symbol::Frame> go::symbol::Symbolizer::symbolize(uint64_t pc) const {
+    std::optional<NativeSymbol> native;
+
+    if (mNative)
+        native = mNative->find(pc);
+
+    auto it = mSymbols.find(pc);
+
+    if (it != mSymbols.end() && (!native || native->start <= (*it).entry())) {
+        SymbolEntry entry = *it;
+        Symbol symbol = entry.symbol();
+
+        Frame frame = {pc, entry.entry(), symbol.name(), nullptr, -1};
+
+        int capabilities = mSymbols.capabilities();
+
+        if (capabilities & PCValueCapability)
+            frame.line = symbol.sourceLine(pc);
+
+        if (capabilities & FileCapability)
+            frame.file = symbol.sourceFile(pc);
+
+        return frame;
+    }
+
+    if (!native)
+        return std::nullopt;
+
+    return Frame{pc, native->start, native->name, nullptr, -1};
+}
+
+const go::symbol::SymbolTable &go::symbol::Symbolizer::symbols() const {
+    return mSymbols;
+}
+
+const std::optional<go::symbol::NativeSymbolTable> &go::symbol::Symbolizer::native() const {
+    return mNative;
+}
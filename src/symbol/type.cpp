@@ -0,0 +1,253 @@
+#include <go/symbol/type.h>
+#include <go/binary.h>
+#include <bit>
+
+constexpr auto KIND_MASK = 0x1f;
+constexpr auto TFLAG_EXTRA_STAR = std::byte{0x2};
+constexpr auto NAME_FLAG_EMBEDDED = std::byte{0x8};
+
+constexpr auto INITIAL_SLOTS = 256;
+constexpr auto HASH_MULTIPLIER = 0x9e3779b97f4a7c15ull;
+
+go::symbol::TypeTable::TypeTable(
+        elf::Reader reader,
+        std::shared_ptr<elf::ISection> section,
+        Version version,
+        uint64_t types,
+        uint64_t etypes,
+        uint64_t base,
+        size_t ptrSize,
+        endian::Converter converter
+) : mReader(std::move(reader)), mSection(std::move(section)), mVersion(version), mTypes(types), mETypes(etypes),
+    mBase(base), mPtrSize(ptrSize), mConverter(converter) {
+    if (mSection)
+        mLinks = {mSection->data(), mSection->size()};
+}
+
+go::symbol::TypeTable::TypeTable(
+        elf::Reader reader,
+        std::span<const std::byte> links,
+        Version version,
+        uint64_t types,
+        uint64_t etypes,
+        uint64_t base,
+        size_t ptrSize,
+        endian::Converter converter
+) : mReader(std::move(reader)), mLinks(links), mVersion(version), mTypes(types), mETypes(etypes), mBase(base),
+    mPtrSize(ptrSize), mConverter(converter) {
+
+}
+
+size_t go::symbol::TypeTable::size() const {
+    return mLinks.size() / sizeof(int32_t);
+}
+
+const go::symbol::Type *go::symbol::TypeTable::operator[](size_t index) {
+    if (index >= size())
+        return nullptr;
+
+    return lookup((uint32_t) mConverter(mLinks.data() + index * sizeof(int32_t), sizeof(int32_t)));
+}
+
+const go::symbol::Type *go::symbol::TypeTable::find(uint64_t address) {
+    if (address - mBase < mTypes || address - mBase >= mETypes)
+        return nullptr;
+
+    return lookup(address - mBase - mTypes);
+}
+
+const go::symbol::Type *go::symbol::TypeTable::lookup(uint64_t offset) {
+    if (offset >= mETypes - mTypes)
+        return nullptr;
+
+    if (!mSlots.empty()) {
+        Type *type = *slot(offset);
+
+        if (type)
+            return type;
+    }
+
+    const std::byte *buffer = memory(offset);
+
+    if (!buffer)
+        return nullptr;
+
+    auto type = mArena.make<Type>(
+            offset,
+            mConverter(buffer, mPtrSize),
+            mConverter(buffer + mPtrSize, mPtrSize),
+            TypeKind(std::to_integer<int>(buffer[2 * mPtrSize + 7]) & KIND_MASK)
+    );
+
+    uint64_t nameOffset = mConverter(buffer + (mPtrSize == 8 ? 40 : 24), 4);
+
+    if (nameOffset) {
+        std::optional<std::pair<std::string_view, bool>> result;
+        const std::byte *ptr = memory(nameOffset);
+
+        if (ptr && (result = name(ptr))) {
+            type->name = result->first;
+
+            if ((buffer[2 * mPtrSize + 4] & TFLAG_EXTRA_STAR) != std::byte{0} && type->name.starts_with('*'))
+                type->name.remove_prefix(1);
+        }
+    }
+
+    insert(type);
+
+    return type;
+}
+
+const go::symbol::Type *go::symbol::TypeTable::key(const Type *type) {
+    if (type->kind != MapKind)
+        return nullptr;
+
+    return reference(type, 0);
+}
+
+const go::symbol::Type *go::symbol::TypeTable::elem(const Type *type) {
+    switch (type->kind) {
+        case ArrayKind:
+        case ChanKind:
+        case PointerKind:
+        case SliceKind:
+            return reference(type, 0);
+
+        case MapKind:
+            return reference(type, 1);
+
+        default:
+            return nullptr;
+    }
+}
+
+std::optional<uint64_t> go::symbol::TypeTable::length(const Type *type) {
+    if (type->kind != ArrayKind)
+        return std::nullopt;
+
+    const std::byte *buffer = memory(type->offset);
+
+    if (!buffer)
+        return std::nullopt;
+
+    return mConverter(buffer + (mPtrSize == 8 ? 48 : 32) + 2 * mPtrSize, mPtrSize);
+}
+
+std::span<const go::symbol::TypeField> go::symbol::TypeTable::fields(const Type *type) {
+    if (type->kind != StructKind || type->decoded)
+        return type->fields;
+
+    Type *node = *slot(type->offset);
+    node->decoded = true;
+
+    const std::byte *buffer = memory(type->offset);
+
+    if (!buffer)
+        return {};
+
+    buffer += (mPtrSize == 8 ? 48 : 32) + mPtrSize;
+
+    const std::byte *fields = mReader.virtualMemory(mConverter(buffer, mPtrSize));
+    uint64_t count = mConverter(buffer + mPtrSize, mPtrSize);
+
+    if (!fields || !count)
+        return {};
+
+    std::span<TypeField> result = mArena.array<TypeField>(count);
+
+    for (size_t i = 0; i < count; i++) {
+        const std::byte *field = fields + i * 3 * mPtrSize;
+        const std::byte *ptr = mReader.virtualMemory(mConverter(field, mPtrSize));
+
+        if (ptr) {
+            std::optional<std::pair<std::string_view, bool>> name = this->name(ptr);
+
+            if (name) {
+                result[i].name = name->first;
+                result[i].embedded = name->second;
+            }
+        }
+
+        result[i].type = mConverter(field + mPtrSize, mPtrSize) - mTypes;
+        result[i].offset = mConverter(field + 2 * mPtrSize, mPtrSize);
+
+        if (mVersion >= Version{1, 9} && mVersion < Version{1, 19}) {
+            result[i].embedded = result[i].offset & 1;
+            result[i].offset >>= 1;
+        }
+    }
+
+    node->fields = result;
+
+    return result;
+}
+
+uint64_t go::symbol::TypeTable::address(const Type *type) const {
+    return mBase + mTypes + type->offset;
+}
+
+const std::byte *go::symbol::TypeTable::memory(uint64_t offset) const {
+    return mReader.virtualMemory(mTypes + offset);
+}
+
+std::optional<std::pair<std::string_view, bool>> go::symbol::TypeTable::name(const std::byte *buffer) const {
+    bool embedded = (buffer[0] & NAME_FLAG_EMBEDDED) != std::byte{0};
+
+    if (mVersion <= Version{1, 16})
+        return std::pair<std::string_view, bool>{
+                {
+                        (const char *) buffer + 3,
+                        std::to_integer<size_t>(buffer[1]) << 8 | std::to_integer<size_t>(buffer[2])
+                },
+                false
+        };
+
+    std::optional<std::pair<uint64_t, int>> result = go::binary::uVarInt(buffer + 1);
+
+    if (!result)
+        return std::nullopt;
+
+    return std::pair<std::string_view, bool>{
+            {(const char *) buffer + 1 + result->second, (size_t) result->first},
+            mVersion >= Version{1, 19} && embedded
+    };
+}
+
+const go::symbol::Type *go::symbol::TypeTable::reference(const Type *type, size_t index) {
+    const std::byte *buffer = memory(type->offset);
+
+    if (!buffer)
+        return nullptr;
+
+    uint64_t address = mConverter(buffer + (mPtrSize == 8 ? 48 : 32) + index * mPtrSize, mPtrSize);
+
+    if (address < mTypes)
+        return nullptr;
+
+    return lookup(address - mTypes);
+}
+
+go::symbol::Type **go::symbol::TypeTable::slot(uint64_t offset) {
+    size_t mask = mSlots.size() - 1;
+    size_t index = (offset * HASH_MULTIPLIER) >> (64 - std::countr_zero(mSlots.size()));
+
+    while (mSlots[index] && mSlots[index]->offset != offset)
+        index = (index + 1) & mask;
+
+    return &mSlots[index];
+}
+
+void go::symbol::TypeTable::insert(Type *type) {
+    if ((mCount + 1) * 4 > mSlots.size() * 3) {
+        std::span<Type *> slots = mSlots;
+        mSlots = mArena.array<Type *>(slots.empty() ? INITIAL_SLOTS : slots.size() * 2);
+
+        for (Type *node: slots) {
+            if (node)
+                *slot(node->offset) = node;
+        }
+    }
+
+    *slot(type->offset) = type;
+    mCount++;
+}
@@ -0,0 +1,157 @@
+#include "fixture.h"
+#include <go/symbol/batch.h>
+#include <random>
+#include <cstring>
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+constexpr auto TEXT_START = 0x400000;
+constexpr auto FUNCTION_COUNT = 64;
+constexpr auto FUNCTION_SIZE = 0x400;
+constexpr auto LINE_STEP = 0x10;
+constexpr auto SOURCE_FILES = 3;
+constexpr auto PC_COUNT = 4096;
+constexpr auto BYTES_BUDGET = 8;
+constexpr auto DEADLINE = std::chrono::microseconds(50);
+
+namespace {
+    std::vector<std::byte> table() {
+        fixture::Table table = {go::symbol::VERSION120, TEXT_START, {}, {}};
+
+        for (int i = 0; i < SOURCE_FILES; i++)
+            table.files.push_back("src/file" + std::to_string(i) + ".go");
+
+        for (size_t i = 0; i < FUNCTION_COUNT; i++) {
+            fixture::Function function = {"main.function" + std::to_string(i), uint32_t(i * FUNCTION_SIZE), {}, 0};
+
+            for (int pc = 0; pc < FUNCTION_SIZE; pc += LINE_STEP)
+                function.steps.push_back(
+                        {
+                                LINE_STEP,
+                                int((i + pc / LINE_STEP) % SOURCE_FILES),
+                                int(i * 100 + pc / LINE_STEP + 1),
+                                0
+                        }
+                );
+
+            table.functions.push_back(std::move(function));
+        }
+
+        return fixture::pclntab(table);
+    }
+
+    std::vector<uint64_t> pcs() {
+        std::mt19937 engine(PC_COUNT);
+        std::uniform_int_distribution<uint64_t> distribution(TEXT_START - LINE_STEP, TEXT_START + FUNCTION_COUNT * FUNCTION_SIZE);
+        std::vector<uint64_t> pcs;
+
+        for (size_t i = 0; i < PC_COUNT; i++)
+            pcs.push_back(distribution(engine));
+
+        return pcs;
+    }
+
+    bool equal(const go::symbol::Frame &lhs, const go::symbol::Frame &rhs) {
+        auto same = [](const char *x, const char *y) {
+            return x == y || (x && y && !strcmp(x, y));
+        };
+
+        return lhs.pc == rhs.pc &&
+               lhs.entry == rhs.entry &&
+               lhs.line == rhs.line &&
+               same(lhs.name, rhs.name) &&
+               same(lhs.file, rhs.file);
+    }
+}
+
+TEST_CASE("batch symbolization resume", "[batch]") {
+    auto capabilities = GENERATE(go::symbol::NameCapability, go::symbol::PCValueCapability, go::symbol::FullCapability);
+
+    go::symbol::SymbolTable symbolTable(
+            go::symbol::VERSION120,
+            go::endian::Converter(elf::endian::Little),
+            fixture::buffer(table()),
+            0
+    );
+
+    std::optional<go::symbol::SymbolTable> compact = symbolTable.compact(
+            capabilities,
+            [](size_t size) {
+                return go::memory::allocate(size);
+            }
+    );
+
+    REQUIRE(compact);
+
+    std::vector<uint64_t> addresses = pcs();
+
+    go::symbol::BatchSymbolizer expected(&*compact, addresses);
+    REQUIRE(expected.resume());
+    REQUIRE(expected.done());
+
+    for (size_t i = 0; i < addresses.size(); i++) {
+        const go::symbol::Frame &frame = expected.frame(i);
+
+        if (!expected.resolved(i)) {
+            REQUIRE(expected.state(i) == go::symbol::UnresolvedFrame);
+            continue;
+        }
+
+        go::symbol::Symbol symbol = symbolTable.find(frame.pc).operator*().symbol();
+
+        REQUIRE(frame.entry == symbol.entry());
+        REQUIRE(strcmp(frame.name, symbol.name()) == 0);
+
+        if (capabilities & go::symbol::PCValueCapability)
+            REQUIRE(frame.line == symbol.sourceLine(frame.pc));
+        else
+            REQUIRE(frame.line == -1);
+
+        if (capabilities & go::symbol::FileCapability)
+            REQUIRE(strcmp(frame.file, symbol.sourceFile(frame.pc)) == 0);
+        else
+            REQUIRE(frame.file == nullptr);
+    }
+
+    SECTION("deadline") {
+        go::symbol::BatchSymbolizer batch(&*compact, addresses);
+
+        REQUIRE(!batch.resume({std::chrono::steady_clock::now(), std::nullopt}));
+        REQUIRE(batch.remaining() == addresses.size());
+
+        while (!batch.resume({std::chrono::steady_clock::now() + DEADLINE, std::nullopt}))
+            REQUIRE(!batch.done());
+
+        REQUIRE(batch.done());
+
+        for (size_t i = 0; i < addresses.size(); i++) {
+            REQUIRE(batch.state(i) == expected.state(i));
+            REQUIRE(equal(batch.frame(i), expected.frame(i)));
+        }
+    }
+
+    SECTION("bytes") {
+        go::symbol::BatchSymbolizer batch(&*compact, addresses);
+        size_t rounds = 0;
+
+        while (!batch.resume({std::nullopt, BYTES_BUDGET})) {
+            REQUIRE(!batch.done());
+            rounds++;
+        }
+
+        REQUIRE(batch.done());
+
+        if (capabilities & go::symbol::PCValueCapability)
+            REQUIRE(rounds > 1);
+
+        for (size_t i = 0; i < addresses.size(); i++) {
+            REQUIRE(batch.state(i) == expected.state(i));
+            REQUIRE(equal(batch.frame(i), expected.frame(i)));
+        }
+    }
+}
@@ -0,0 +1,156 @@
+#include "fixture.h"
+#include <go/symbol/budget.h>
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+constexpr auto TEXT_START = 0x400000;
+constexpr auto SECTION_ADDRESS = 0x800000;
+constexpr auto FUNCTION_COUNT = 256;
+constexpr auto FUNCTION_SIZE = 0x40;
+constexpr auto SOURCE_FILES = 4;
+
+namespace {
+    std::vector<std::byte> image() {
+        fixture::Table table = {go::symbol::VERSION120, TEXT_START, {}, {}};
+
+        for (int i = 0; i < SOURCE_FILES; i++)
+            table.files.push_back("src/file" + std::to_string(i) + ".go");
+
+        for (size_t i = 0; i < FUNCTION_COUNT; i++)
+            table.functions.push_back(
+                    {
+                            "main.function" + std::to_string(i),
+                            uint32_t(i * FUNCTION_SIZE),
+                            {{FUNCTION_SIZE, int(i % SOURCE_FILES), int(i + 1), 0}},
+                            0
+                    }
+            );
+
+        std::vector<std::byte> data = fixture::pclntab(table);
+
+        return fixture::elf(
+                {
+                        ET_EXEC,
+                        {{SECTION_ADDRESS, data}},
+                        {{".gopclntab", SHT_PROGBITS, SHF_ALLOC, SECTION_ADDRESS, data}}
+                }
+        );
+    }
+}
+
+TEST_CASE("managed table string pool", "[budget]") {
+    fixture::TemporaryFile file(image());
+    std::optional<go::symbol::Reader> reader = go::symbol::openFile(file.path());
+    REQUIRE(reader);
+
+    SECTION("explicit pool") {
+        go::symbol::StringPool pool;
+        go::symbol::ManagedSymbolTable table(*reader, {}, 0, &pool);
+
+        REQUIRE(table.open(go::symbol::AnonymousTable));
+        REQUIRE(table.nameIndex());
+
+        size_t names = pool.usage().strings;
+        REQUIRE(names >= FUNCTION_COUNT);
+
+        REQUIRE(table.fileIndex());
+        REQUIRE(pool.usage().strings > names);
+
+        REQUIRE(table.shrink());
+        REQUIRE(pool.usage().strings == names);
+
+        REQUIRE(table.shrink());
+        REQUIRE(pool.usage().strings == 0);
+    }
+
+    SECTION("global pool by default") {
+        go::symbol::StringPool &pool = go::symbol::StringPool::global();
+        size_t strings = pool.usage().strings;
+
+        go::symbol::ManagedSymbolTable table(*reader);
+
+        REQUIRE(table.open(go::symbol::AnonymousTable));
+        REQUIRE(table.nameIndex());
+        REQUIRE(pool.usage().strings >= strings + FUNCTION_COUNT);
+
+        REQUIRE(table.shrink());
+        REQUIRE(pool.usage().strings == strings);
+    }
+
+    SECTION("unpooled") {
+        go::symbol::ManagedSymbolTable table(*reader, {}, 0, nullptr);
+
+        REQUIRE(table.open(go::symbol::AnonymousTable));
+
+        std::shared_ptr<const go::symbol::NameIndex> index = table.nameIndex();
+        std::optional<uint32_t> id = index->find(go::symbol::MethodNameSpace, "function7");
+
+        REQUIRE(id);
+        REQUIRE(!index->poolID(go::symbol::MethodNameSpace, *id));
+    }
+}
+
+TEST_CASE("managed table downgrade order", "[budget]") {
+    fixture::TemporaryFile file(image());
+    std::optional<go::symbol::Reader> reader = go::symbol::openFile(file.path());
+    REQUIRE(reader);
+
+    SECTION("shrink") {
+        go::symbol::ManagedSymbolTable table(*reader);
+
+        REQUIRE(table.open(go::symbol::AnonymousTable));
+        REQUIRE(table.nameIndex());
+        REQUIRE(table.fileIndex());
+
+        std::shared_ptr<const go::symbol::SymbolTable> anonymous = table.symbols();
+        REQUIRE(anonymous);
+
+        REQUIRE(table.shrink());
+        REQUIRE(table.mode() == go::symbol::AnonymousTable);
+
+        REQUIRE(table.shrink());
+        REQUIRE(table.mode() == go::symbol::AnonymousTable);
+        REQUIRE(table.symbols() == anonymous);
+
+        REQUIRE(table.shrink());
+        REQUIRE(table.mode() == go::symbol::MappedTable);
+        REQUIRE(table.symbols());
+        REQUIRE(table.symbols() != anonymous);
+        REQUIRE(!table.seekSymbols());
+
+        REQUIRE(table.shrink());
+        REQUIRE(table.mode() == go::symbol::SeekTable);
+        REQUIRE(!table.symbols());
+        REQUIRE(table.seekSymbols());
+
+        REQUIRE(!table.shrink());
+        REQUIRE(table.mode() == go::symbol::SeekTable);
+
+        REQUIRE(anonymous->size() == FUNCTION_COUNT);
+        REQUIRE(std::string_view{anonymous->find(TEXT_START).operator*().symbol().name()} == "main.function0");
+    }
+
+    SECTION("budget manager") {
+        auto table = std::make_shared<go::symbol::ManagedSymbolTable>(*reader);
+        REQUIRE(table->open(go::symbol::AnonymousTable));
+        REQUIRE(table->nameIndex());
+
+        go::symbol::BudgetManager manager(1);
+        manager.add(table);
+
+        REQUIRE(table->mode() == go::symbol::SeekTable);
+        REQUIRE(!table->shrink());
+    }
+
+    SECTION("mapped regions") {
+        go::memory::Usage usage = reader->memoryUsage();
+
+        REQUIRE(usage.heap == 0);
+        REQUIRE(usage.mapped > 0);
+        REQUIRE(usage.mapped < std::filesystem::file_size(file.path()));
+    }
+}
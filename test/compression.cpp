@@ -0,0 +1,172 @@
+#include "fixture.h"
+#include <go/symbol/reader.h>
+#include <zlib.h>
+#include <zstd.h>
+#include <random>
+#include <numeric>
+#include <algorithm>
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+constexpr auto TEXT_START = 0x400000;
+constexpr auto SECTION_ADDRESS = 0x800000;
+constexpr auto LOAD_ADDRESS = 0x1000;
+
+constexpr auto FUNCTION_COUNT = 16384;
+constexpr auto FUNCTION_SIZE = 0x40;
+constexpr auto LINE_STEP = 0x10;
+constexpr auto NAME_SIZE = 96;
+constexpr auto SOURCE_FILES = 3;
+constexpr auto SAMPLE_COUNT = 1024;
+
+constexpr auto CHECKPOINT_INTERVAL = 1024 * 1024;
+constexpr auto ZSTD_FRAMES = 3;
+
+constexpr auto ELF_COMPRESS_ZLIB = 1;
+constexpr auto ELF_COMPRESS_ZSTD = 2;
+
+constexpr auto CHDR32_SIZE = 12;
+constexpr auto CHDR64_SIZE = 24;
+
+namespace {
+    enum Method {
+        Zlib,
+        ZstdSingleFrame,
+        ZstdMultiFrame
+    };
+
+    std::string name(size_t index) {
+        std::string name = "main.function" + std::to_string(index) + ".";
+        name.resize(NAME_SIZE, 'x');
+        return name;
+    }
+
+    std::vector<std::byte> table() {
+        fixture::Table table = {go::symbol::VERSION120, TEXT_START, {}, {}};
+
+        for (int i = 0; i < SOURCE_FILES; i++)
+            table.files.push_back("src/file" + std::to_string(i) + ".go");
+
+        for (size_t i = 0; i < FUNCTION_COUNT; i++) {
+            fixture::Function function = {name(i), uint32_t(i * FUNCTION_SIZE), {}, 0};
+
+            for (int pc = 0; pc < FUNCTION_SIZE; pc += LINE_STEP)
+                function.steps.push_back({LINE_STEP, int(i % SOURCE_FILES), int(i + pc / LINE_STEP + 1), 0});
+
+            table.functions.push_back(std::move(function));
+        }
+
+        return fixture::pclntab(table);
+    }
+
+    std::vector<std::byte> compress(std::span<const std::byte> data, Method method) {
+        std::vector<std::byte> compressed;
+
+        if (method == Zlib) {
+            uLongf size = compressBound(data.size());
+            compressed.resize(size);
+
+            REQUIRE(compress2(
+                    (Bytef *) compressed.data(),
+                    &size,
+                    (const Bytef *) data.data(),
+                    data.size(),
+                    Z_DEFAULT_COMPRESSION
+            ) == Z_OK);
+
+            compressed.resize(size);
+            return compressed;
+        }
+
+        size_t frames = method == ZstdSingleFrame ? 1 : ZSTD_FRAMES;
+        size_t frameSize = (data.size() + frames - 1) / frames;
+
+        for (size_t offset = 0; offset < data.size(); offset += frameSize) {
+            std::span<const std::byte> frame = data.subspan(offset, std::min(frameSize, data.size() - offset));
+            std::vector<std::byte> buffer(ZSTD_compressBound(frame.size()));
+
+            size_t size = ZSTD_compress(buffer.data(), buffer.size(), frame.data(), frame.size(), 1);
+            REQUIRE(!ZSTD_isError(size));
+
+            compressed.insert(compressed.end(), buffer.begin(), buffer.begin() + std::ptrdiff_t(size));
+        }
+
+        return compressed;
+    }
+
+    std::vector<std::byte> section(std::span<const std::byte> data, Method method, uint8_t elfClass) {
+        std::vector<std::byte> section;
+        uint32_t type = method == Zlib ? ELF_COMPRESS_ZLIB : ELF_COMPRESS_ZSTD;
+
+        if (elfClass == ELFCLASS32) {
+            fixture::append(section, type, 4);
+            fixture::append(section, data.size(), 4);
+            fixture::append(section, 8, 4);
+            REQUIRE(section.size() == CHDR32_SIZE);
+        } else {
+            fixture::append(section, type, 4);
+            fixture::append(section, 0, 4);
+            fixture::append(section, data.size(), 8);
+            fixture::append(section, 8, 8);
+            REQUIRE(section.size() == CHDR64_SIZE);
+        }
+
+        std::vector<std::byte> compressed = compress(data, method);
+        section.insert(section.end(), compressed.begin(), compressed.end());
+
+        return section;
+    }
+}
+
+TEST_CASE("compressed symbol section", "[compression]") {
+    auto method = GENERATE(Zlib, ZstdSingleFrame, ZstdMultiFrame);
+    auto elfClass = GENERATE(uint8_t(ELFCLASS32), uint8_t(ELFCLASS64));
+
+    std::vector<std::byte> data = table();
+    REQUIRE(data.size() > 2 * CHECKPOINT_INTERVAL);
+
+    go::symbol::SymbolTable expected(
+            go::symbol::VERSION120,
+            go::endian::Converter(elf::endian::Little),
+            data.data(),
+            0
+    );
+
+    fixture::TemporaryFile file(fixture::elf(
+            {
+                    ET_EXEC,
+                    {{LOAD_ADDRESS, std::vector<std::byte>(16)}},
+                    {{".gopclntab", SHT_PROGBITS, SHF_ALLOC | SHF_COMPRESSED, SECTION_ADDRESS, section(data, method, elfClass)}},
+                    elfClass
+            }
+    ));
+
+    std::optional<go::symbol::Reader> reader = go::symbol::openFile(file.path());
+    REQUIRE(reader);
+
+    std::optional<go::symbol::seek::SymbolTable> table = reader->symbols();
+    REQUIRE(table);
+    REQUIRE(table->size() == expected.size());
+
+    std::vector<size_t> indexes(FUNCTION_COUNT);
+    std::iota(indexes.begin(), indexes.end(), 0);
+    std::shuffle(indexes.begin(), indexes.end(), std::mt19937(FUNCTION_COUNT));
+    indexes.resize(SAMPLE_COUNT);
+
+    for (size_t i: indexes) {
+        uint64_t pc = TEXT_START + i * FUNCTION_SIZE + FUNCTION_SIZE - 1;
+
+        go::symbol::Symbol symbol = expected.find(pc).operator*().symbol();
+        go::symbol::seek::Symbol seekSymbol = table->find(pc).operator*().symbol();
+
+        REQUIRE(seekSymbol.entry() == symbol.entry());
+        REQUIRE(seekSymbol.name() == symbol.name());
+        REQUIRE(seekSymbol.sourceLine(pc) == symbol.sourceLine(pc));
+        REQUIRE(seekSymbol.sourceFile(pc) == symbol.sourceFile(pc));
+    }
+}
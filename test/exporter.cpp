@@ -0,0 +1,156 @@
+#include "fixture.h"
+#include <go/symbol/exporter.h>
+#include <sstream>
+#include <cstring>
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+constexpr auto TEXT_START = 0x400000;
+constexpr auto FUNCTION_COUNT = 700;
+constexpr auto FUNCTION_SIZE = 0x40;
+constexpr auto BPF_PAGE_SIZE = 4096;
+
+namespace {
+    std::string name(size_t index) {
+        return "main.function" + std::to_string(index);
+    }
+
+    bool empty(size_t index) {
+        return index % 100 == 50;
+    }
+
+    std::vector<std::byte> table(elf::endian::Type endian) {
+        fixture::Table table = {go::symbol::VERSION120, TEXT_START, {"main.go"}, {}, endian};
+        uint32_t entry = 0;
+
+        for (size_t i = 0; i < FUNCTION_COUNT; i++) {
+            fixture::Function function = {name(i), entry, {}, 0};
+
+            if (!empty(i))
+                function.steps.push_back({FUNCTION_SIZE, 0, int(i), 0});
+
+            entry += empty(i) ? 0 : FUNCTION_SIZE;
+            table.functions.push_back(std::move(function));
+        }
+
+        return fixture::pclntab(table);
+    }
+
+    template<typename T>
+    T load(const std::string &buffer, size_t offset) {
+        T value;
+        REQUIRE(offset + sizeof(T) <= buffer.size());
+        memcpy(&value, buffer.data() + offset, sizeof(T));
+        return value;
+    }
+
+    std::pair<std::string, std::string> bpf(elf::endian::Type endian) {
+        std::vector<std::byte> buffer = table(endian);
+        go::symbol::SymbolTable symbolTable(go::symbol::VERSION120, go::endian::Converter(endian), buffer.data(), 0);
+
+        std::ostringstream ranges;
+        std::ostringstream names;
+
+        REQUIRE(go::symbol::Exporter(&symbolTable).bpf(ranges, names));
+
+        return {ranges.str(), names.str()};
+    }
+}
+
+TEST_CASE("bpf range export", "[exporter]") {
+    auto [ranges, names] = bpf(elf::endian::Little);
+
+    size_t count = 0;
+
+    for (size_t i = 0; i < FUNCTION_COUNT; i++) {
+        if (!empty(i))
+            count++;
+    }
+
+    uint64_t end = TEXT_START + count * FUNCTION_SIZE;
+
+    SECTION("header is host endian") {
+        uint32_t magic = go::symbol::BPF_RANGE_MAGIC;
+        REQUIRE(memcmp(ranges.data(), &magic, sizeof(magic)) == 0);
+
+        auto header = load<go::symbol::BPFRangeHeader>(ranges, 0);
+
+        REQUIRE(header.magic == go::symbol::BPF_RANGE_MAGIC);
+        REQUIRE(header.version == go::symbol::BPF_RANGE_VERSION);
+        REQUIRE(header.offset == sizeof(go::symbol::BPFRangeHeader));
+        REQUIRE(header.count == count + 1);
+        REQUIRE(header.base == TEXT_START);
+        REQUIRE(header.end == end);
+    }
+
+    SECTION("entries are sorted deltas with a sentinel") {
+        auto header = load<go::symbol::BPFRangeHeader>(ranges, 0);
+        uint32_t id = 0;
+
+        for (size_t i = 0; i < FUNCTION_COUNT; i++) {
+            if (empty(i))
+                continue;
+
+            auto range = load<go::symbol::BPFRange>(ranges, header.offset + id * sizeof(go::symbol::BPFRange));
+
+            REQUIRE(range.delta == id * FUNCTION_SIZE);
+            REQUIRE(range.id == id);
+
+            id++;
+        }
+
+        auto sentinel = load<go::symbol::BPFRange>(ranges, header.offset + id * sizeof(go::symbol::BPFRange));
+
+        REQUIRE(sentinel.delta == end - TEXT_START);
+        REQUIRE(sentinel.id == UINT32_MAX);
+    }
+
+    SECTION("padded to a page with maximal entries") {
+        auto header = load<go::symbol::BPFRangeHeader>(ranges, 0);
+
+        REQUIRE(ranges.size() % BPF_PAGE_SIZE == 0);
+        REQUIRE(ranges.size() > BPF_PAGE_SIZE);
+
+        size_t padding = header.offset + header.count * sizeof(go::symbol::BPFRange);
+
+        REQUIRE(padding < ranges.size());
+        REQUIRE(ranges.size() - padding < BPF_PAGE_SIZE);
+
+        for (size_t offset = padding; offset < ranges.size(); offset += sizeof(go::symbol::BPFRange)) {
+            auto range = load<go::symbol::BPFRange>(ranges, offset);
+
+            REQUIRE(range.delta == UINT32_MAX);
+            REQUIRE(range.id == UINT32_MAX);
+        }
+    }
+
+    SECTION("names stream") {
+        REQUIRE(load<uint32_t>(names, 0) == count);
+
+        size_t strings = sizeof(uint32_t) * (count + 1);
+        uint32_t id = 0;
+
+        for (size_t i = 0; i < FUNCTION_COUNT; i++) {
+            if (empty(i))
+                continue;
+
+            auto offset = load<uint32_t>(names, sizeof(uint32_t) * (id + 1));
+            REQUIRE(std::string_view(names.c_str() + strings + offset) == name(i));
+
+            id++;
+        }
+
+        REQUIRE(names.back() == '\0');
+    }
+
+    SECTION("big endian tables export host endian ranges") {
+        auto [bigRanges, bigNames] = bpf(elf::endian::Big);
+
+        REQUIRE(bigRanges == ranges);
+        REQUIRE(bigNames == names);
+    }
+}
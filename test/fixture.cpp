@@ -0,0 +1,330 @@
+#include "fixture.h"
+#include <elf.h>
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+
+constexpr auto PAGE_SIZE = 0x1000;
+constexpr auto SECTION_ALIGNMENT = 8;
+constexpr auto PCLNTAB_HEADER_SIZE = 72;
+
+namespace {
+    size_t align(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    template<typename T>
+    void write(std::vector<std::byte> &buffer, size_t offset, const T &value) {
+        if (buffer.size() < offset + sizeof(T))
+            buffer.resize(offset + sizeof(T));
+
+        memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    void copy(std::vector<std::byte> &buffer, size_t offset, std::span<const std::byte> data) {
+        if (buffer.size() < offset + data.size())
+            buffer.resize(offset + data.size());
+
+        std::copy(data.begin(), data.end(), buffer.begin() + std::ptrdiff_t(offset));
+    }
+
+    template<typename Ehdr, typename Phdr, typename Shdr>
+    std::vector<std::byte> build(const fixture::Image &image) {
+        std::vector<std::byte> buffer;
+        std::vector<Phdr> programs;
+        std::vector<Shdr> sections(1);
+
+        size_t offset = sizeof(Ehdr) + image.segments.size() * sizeof(Phdr);
+
+        for (const auto &segment: image.segments) {
+            offset = align(offset, PAGE_SIZE) + segment.address % PAGE_SIZE;
+
+            Phdr program = {};
+
+            program.p_type = segment.type;
+            program.p_flags = segment.flags;
+            program.p_offset = offset;
+            program.p_vaddr = segment.address;
+            program.p_paddr = segment.address;
+            program.p_filesz = segment.data.size();
+            program.p_memsz = segment.data.size();
+            program.p_align = PAGE_SIZE;
+
+            copy(buffer, offset, segment.data);
+            programs.push_back(program);
+
+            offset += segment.data.size();
+        }
+
+        std::string names(1, '\0');
+
+        for (const auto &section: image.sections) {
+            Shdr header = {};
+
+            header.sh_name = names.size();
+            header.sh_type = section.type;
+            header.sh_flags = section.flags;
+            header.sh_addr = section.address;
+            header.sh_size = section.data.size();
+            header.sh_addralign = SECTION_ALIGNMENT;
+
+            names += section.name;
+            names += '\0';
+
+            auto it = std::find_if(programs.begin(), programs.end(), [&](const auto &program) {
+                return section.address && section.address >= program.p_vaddr &&
+                       section.address + section.data.size() <= program.p_vaddr + program.p_filesz;
+            });
+
+            if (it != programs.end()) {
+                header.sh_offset = it->p_offset + (section.address - it->p_vaddr);
+            } else {
+                offset = align(offset, SECTION_ALIGNMENT);
+                header.sh_offset = offset;
+
+                copy(buffer, offset, section.data);
+                offset += section.data.size();
+            }
+
+            sections.push_back(header);
+        }
+
+        Shdr table = {};
+
+        table.sh_name = names.size();
+        table.sh_type = SHT_STRTAB;
+
+        names += ".shstrtab";
+        names += '\0';
+
+        table.sh_offset = offset;
+        table.sh_size = names.size();
+        table.sh_addralign = 1;
+
+        copy(buffer, offset, std::as_bytes(std::span{names}));
+        offset = align(offset + names.size(), SECTION_ALIGNMENT);
+
+        sections.push_back(table);
+
+        Ehdr header = {};
+
+        memcpy(header.e_ident, ELFMAG, SELFMAG);
+        header.e_ident[EI_CLASS] = image.elfClass;
+        header.e_ident[EI_DATA] = ELFDATA2LSB;
+        header.e_ident[EI_VERSION] = EV_CURRENT;
+        header.e_type = image.type;
+        header.e_machine = EM_X86_64;
+        header.e_version = EV_CURRENT;
+        header.e_phoff = image.segments.empty() ? 0 : sizeof(Ehdr);
+        header.e_shoff = offset;
+        header.e_ehsize = sizeof(Ehdr);
+        header.e_phentsize = sizeof(Phdr);
+        header.e_phnum = programs.size();
+        header.e_shentsize = sizeof(Shdr);
+        header.e_shnum = sections.size();
+        header.e_shstrndx = sections.size() - 1;
+
+        write(buffer, 0, header);
+
+        for (size_t i = 0; i < programs.size(); i++)
+            write(buffer, sizeof(Ehdr) + i * sizeof(Phdr), programs[i]);
+
+        for (size_t i = 0; i < sections.size(); i++)
+            write(buffer, offset + i * sizeof(Shdr), sections[i]);
+
+        return buffer;
+    }
+}
+
+fixture::TemporaryFile::TemporaryFile(std::span<const std::byte> content) {
+    static std::atomic<int> counter;
+
+    mPath = std::filesystem::temp_directory_path() /
+            ("go-symbol-test-" + std::to_string(getpid()) + "-" + std::to_string(counter++));
+
+    std::ofstream stream(mPath, std::ios::binary);
+    stream.write((const char *) content.data(), (std::streamsize) content.size());
+}
+
+fixture::TemporaryFile::~TemporaryFile() {
+    std::error_code ec;
+    std::filesystem::remove(mPath, ec);
+}
+
+const std::filesystem::path &fixture::TemporaryFile::path() const {
+    return mPath;
+}
+
+void fixture::put(std::vector<std::byte> &buffer, size_t offset, uint64_t value, size_t size) {
+    if (buffer.size() < offset + size)
+        buffer.resize(offset + size);
+
+    for (size_t i = 0; i < size; i++)
+        buffer[offset + i] = std::byte(value >> (i * 8));
+}
+
+void fixture::append(std::vector<std::byte> &buffer, uint64_t value, size_t size) {
+    put(buffer, buffer.size(), value, size);
+}
+
+void fixture::append(std::vector<std::byte> &buffer, std::string_view str) {
+    auto ptr = reinterpret_cast<const std::byte *>(str.data());
+    buffer.insert(buffer.end(), ptr, ptr + str.size());
+}
+
+void fixture::uVarInt(std::vector<std::byte> &buffer, uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(std::byte(value | 0x80));
+        value >>= 7;
+    }
+
+    buffer.push_back(std::byte(value));
+}
+
+void fixture::varInt(std::vector<std::byte> &buffer, int64_t value) {
+    uVarInt(buffer, uint64_t(value) << 1 ^ uint64_t(value >> 63));
+}
+
+std::vector<std::byte> fixture::elf(const Image &image) {
+    if (image.elfClass == ELFCLASS32)
+        return build<Elf32_Ehdr, Elf32_Phdr, Elf32_Shdr>(image);
+
+    return build<Elf64_Ehdr, Elf64_Phdr, Elf64_Shdr>(image);
+}
+
+std::vector<std::byte> fixture::pclntab(const Table &table) {
+    bool go120 = table.version == go::symbol::VERSION120;
+
+    std::vector<std::byte> buffer(PCLNTAB_HEADER_SIZE);
+
+    auto store = [&](size_t offset, uint64_t value, size_t size) {
+        put(buffer, offset, value, size);
+
+        if (table.endian == elf::endian::Big)
+            std::reverse(buffer.begin() + std::ptrdiff_t(offset), buffer.begin() + std::ptrdiff_t(offset + size));
+    };
+
+    store(0, go120 ? 0xfffffff1 : 0xfffffff0, 4);
+    store(6, 1, 1);
+    store(7, 8, 1);
+    store(8, table.functions.size(), 8);
+    store(16, table.files.size(), 8);
+    store(24, table.textStart, 8);
+
+    std::vector<uint32_t> names;
+    store(32, buffer.size(), 8);
+
+    for (const auto &function: table.functions) {
+        names.push_back(uint32_t(buffer.size() - PCLNTAB_HEADER_SIZE));
+        append(buffer, function.name);
+        buffer.push_back(std::byte{0});
+    }
+
+    buffer.resize(align(buffer.size(), 4));
+    store(40, buffer.size(), 8);
+
+    size_t fileTable = buffer.size() + table.files.size() * 4;
+    size_t fileOffset = 1;
+
+    for (const auto &file: table.files) {
+        store(buffer.size(), fileOffset, 4);
+        fileOffset += file.size() + 1;
+    }
+
+    store(48, fileTable, 8);
+    buffer.push_back(std::byte{0});
+
+    for (const auto &file: table.files) {
+        append(buffer, file);
+        buffer.push_back(std::byte{0});
+    }
+
+    size_t pcTable = buffer.size();
+    store(56, pcTable, 8);
+    buffer.push_back(std::byte{0});
+
+    auto encode = [&](const Function &function, int Step::*member) {
+        auto offset = uint32_t(buffer.size() - pcTable);
+        int previous = -1;
+        uint32_t size = 0;
+
+        for (size_t i = 0; i < function.steps.size(); i++) {
+            size += function.steps[i].size;
+
+            if (i + 1 < function.steps.size() && function.steps[i + 1].*member == function.steps[i].*member)
+                continue;
+
+            varInt(buffer, function.steps[i].*member - previous);
+            uVarInt(buffer, size);
+
+            previous = function.steps[i].*member;
+            size = 0;
+        }
+
+        buffer.push_back(std::byte{0});
+        return offset;
+    };
+
+    std::vector<std::array<uint32_t, 3>> streams;
+
+    for (const auto &function: table.functions)
+        streams.push_back({encode(function, &Step::sp), encode(function, &Step::file), encode(function, &Step::line)});
+
+    buffer.resize(align(buffer.size(), 8));
+
+    size_t funcTable = buffer.size();
+    size_t funcData = (table.functions.size() + 1) * 8;
+    size_t funcSize = go120 ? 44 : 40;
+
+    store(64, funcTable, 8);
+    buffer.resize(funcTable + funcData + table.functions.size() * funcSize);
+
+    for (size_t i = 0; i < table.functions.size(); i++) {
+        const Function &function = table.functions[i];
+        size_t offset = funcTable + funcData + i * funcSize;
+
+        store(funcTable + i * 8, function.entry, 4);
+        store(funcTable + i * 8 + 4, funcData + i * funcSize, 4);
+
+        store(offset, function.entry, 4);
+        store(offset + 4, names[i], 4);
+        store(offset + 16, streams[i][0], 4);
+        store(offset + 20, streams[i][1], 4);
+        store(offset + 24, streams[i][2], 4);
+
+        if (go120) {
+            store(offset + 36, function.steps.empty() ? 0 : function.steps.front().line, 4);
+            store(offset + 41, function.flag, 1);
+        } else {
+            store(offset + 37, function.flag, 1);
+        }
+    }
+
+    if (!table.functions.empty()) {
+        const Function &last = table.functions.back();
+        uint32_t end = last.entry;
+
+        for (const auto &step: last.steps)
+            end += step.size;
+
+        size_t offset = funcTable + table.functions.size() * 8;
+
+        store(offset, end, 4);
+        store(offset + 4, funcData + (table.functions.size() - 1) * funcSize, 4);
+    }
+
+    return buffer;
+}
+
+go::memory::Buffer fixture::buffer(std::span<const std::byte> data) {
+    std::optional<go::memory::Buffer> buffer = go::memory::allocate(data.size());
+
+    if (!buffer)
+        throw std::bad_alloc();
+
+    std::copy(data.begin(), data.end(), buffer->data());
+    return std::move(*buffer);
+}
@@ -0,0 +1,86 @@
+#ifndef GO_SYMBOL_TEST_FIXTURE_H
+#define GO_SYMBOL_TEST_FIXTURE_H
+
+#include <span>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+#include <elf.h>
+#include <go/symbol/symbol.h>
+
+namespace fixture {
+    struct Segment {
+        uint64_t address;
+        std::vector<std::byte> data;
+        uint32_t type = PT_LOAD;
+        uint32_t flags = PF_R;
+    };
+
+    struct Section {
+        std::string name;
+        uint32_t type;
+        uint64_t flags;
+        uint64_t address;
+        std::vector<std::byte> data;
+    };
+
+    struct Image {
+        uint16_t type;
+        std::vector<Segment> segments;
+        std::vector<Section> sections;
+        uint8_t elfClass = ELFCLASS64;
+    };
+
+    struct Step {
+        uint32_t size;
+        int file;
+        int line;
+        int sp;
+    };
+
+    struct Function {
+        std::string name;
+        uint32_t entry;
+        std::vector<Step> steps;
+        uint8_t flag;
+    };
+
+    struct Table {
+        go::symbol::SymbolVersion version;
+        uint64_t textStart;
+        std::vector<std::string> files;
+        std::vector<Function> functions;
+        elf::endian::Type endian = elf::endian::Little;
+    };
+
+    class TemporaryFile {
+    public:
+        explicit TemporaryFile(std::span<const std::byte> content);
+        TemporaryFile(const TemporaryFile &) = delete;
+        ~TemporaryFile();
+
+    public:
+        TemporaryFile &operator=(const TemporaryFile &) = delete;
+
+    public:
+        [[nodiscard]] const std::filesystem::path &path() const;
+
+    private:
+        std::filesystem::path mPath;
+    };
+
+    void put(std::vector<std::byte> &buffer, size_t offset, uint64_t value, size_t size);
+    void append(std::vector<std::byte> &buffer, uint64_t value, size_t size);
+    void append(std::vector<std::byte> &buffer, std::string_view str);
+
+    void uVarInt(std::vector<std::byte> &buffer, uint64_t value);
+    void varInt(std::vector<std::byte> &buffer, int64_t value);
+
+    std::vector<std::byte> elf(const Image &image);
+    std::vector<std::byte> pclntab(const Table &table);
+    go::memory::Buffer buffer(std::span<const std::byte> data);
+}
+
+#endif //GO_SYMBOL_TEST_FIXTURE_H
@@ -0,0 +1,391 @@
+#include "fixture.h"
+#include <go/symbol/layer.h>
+#include <zlib.h>
+#include <cstring>
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+constexpr auto TAR_BLOCK_SIZE = 512;
+constexpr auto TAR_SIZE_OFFSET = 124;
+constexpr auto TAR_SIZE_SIZE = 12;
+constexpr auto TAR_CHECKSUM_OFFSET = 148;
+constexpr auto TAR_CHECKSUM_SIZE = 8;
+constexpr auto TAR_TYPE_OFFSET = 156;
+constexpr auto TAR_LINK_OFFSET = 157;
+constexpr auto TAR_MAGIC_OFFSET = 257;
+constexpr auto TAR_PREFIX_OFFSET = 345;
+
+constexpr auto BUILD_INFO_ADDRESS = 0x10000;
+constexpr auto BUILD_INFO_MAGIC = "\xff Go buildinf:";
+constexpr auto POINTER_FREE_FLAG = 0x2;
+
+constexpr auto GZIP_WINDOW_BITS = 16 + MAX_WBITS;
+constexpr auto FILLER_SIZE = 5 * 1024 * 1024;
+constexpr auto FILLER_COUNT = 4;
+
+namespace {
+    struct Header {
+        std::string name;
+        char type = '0';
+        uint64_t size = 0;
+        std::string link;
+        std::string prefix;
+        bool binary = false;
+    };
+
+    std::vector<std::byte> binary(int minor) {
+        std::string version = "go1." + std::to_string(minor);
+        std::vector<std::byte> data;
+
+        fixture::append(data, BUILD_INFO_MAGIC);
+        fixture::put(data, 14, 8, 1);
+        fixture::put(data, 15, POINTER_FREE_FLAG, 1);
+        data.resize(32);
+        fixture::uVarInt(data, version.size());
+        fixture::append(data, version);
+        fixture::uVarInt(data, 0);
+        data.resize(64);
+
+        return fixture::elf({ET_EXEC, {{BUILD_INFO_ADDRESS, data}}, {}});
+    }
+
+    std::vector<std::byte> filler(size_t size, uint64_t seed) {
+        std::vector<std::byte> data(size);
+
+        for (auto &b: data) {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            b = std::byte(seed);
+        }
+
+        return data;
+    }
+
+    class Archive {
+    public:
+        void header(const Header &header) {
+            std::vector<std::byte> block(TAR_BLOCK_SIZE);
+
+            auto text = [&](size_t offset, std::string_view value) {
+                memcpy(block.data() + offset, value.data(), value.size());
+            };
+
+            auto octal = [&](size_t offset, size_t size, uint64_t value) {
+                for (size_t i = size - 1; i > 0; i--, value >>= 3)
+                    block[offset + i - 1] = std::byte('0' + (value & 7));
+            };
+
+            text(0, header.name);
+            octal(100, 8, 0644);
+            octal(108, 8, 0);
+            octal(116, 8, 0);
+            octal(136, 12, 0);
+            text(TAR_LINK_OFFSET, header.link);
+            text(TAR_MAGIC_OFFSET, "ustar");
+            text(TAR_MAGIC_OFFSET + 6, "00");
+            text(TAR_PREFIX_OFFSET, header.prefix);
+
+            block[TAR_TYPE_OFFSET] = std::byte(header.type);
+
+            if (header.binary) {
+                bool negative = int64_t(header.size) < 0;
+
+                std::fill_n(block.begin() + TAR_SIZE_OFFSET, TAR_SIZE_SIZE, std::byte(negative ? 0xff : 0));
+
+                for (size_t i = 0; i < 8; i++)
+                    block[TAR_SIZE_OFFSET + TAR_SIZE_SIZE - 1 - i] = std::byte(header.size >> (i * 8));
+
+                if (!negative)
+                    block[TAR_SIZE_OFFSET] = std::byte{0x80};
+            } else {
+                octal(TAR_SIZE_OFFSET, TAR_SIZE_SIZE, header.size);
+            }
+
+            std::fill_n(block.begin() + TAR_CHECKSUM_OFFSET, TAR_CHECKSUM_SIZE, std::byte{' '});
+
+            uint64_t sum = 0;
+
+            for (std::byte b: block)
+                sum += std::to_integer<uint8_t>(b);
+
+            octal(TAR_CHECKSUM_OFFSET, TAR_CHECKSUM_SIZE - 1, sum);
+            mData.insert(mData.end(), block.begin(), block.end());
+        }
+
+        void data(std::span<const std::byte> data) {
+            mData.insert(mData.end(), data.begin(), data.end());
+            mData.resize((mData.size() + TAR_BLOCK_SIZE - 1) / TAR_BLOCK_SIZE * TAR_BLOCK_SIZE);
+        }
+
+        void file(const std::string &name, std::span<const std::byte> content) {
+            header({name, '0', content.size()});
+            data(content);
+        }
+
+        void extended(char type, std::string_view payload) {
+            header({"././@LongLink", type, payload.size()});
+            data(std::as_bytes(std::span{payload}));
+        }
+
+        void pax(const std::vector<std::pair<std::string, std::string>> &records) {
+            std::string payload;
+
+            for (const auto &[key, value]: records) {
+                std::string record = " " + key + "=" + value + "\n";
+                size_t length = record.size() + 1;
+
+                while (std::to_string(length).size() + record.size() != length)
+                    length++;
+
+                payload += std::to_string(length) + record;
+            }
+
+            header({"PaxHeaders/entry", 'x', payload.size()});
+            data(std::as_bytes(std::span{payload}));
+        }
+
+        std::vector<std::byte> finish() {
+            mData.resize(mData.size() + 2 * TAR_BLOCK_SIZE);
+            return mData;
+        }
+
+    private:
+        std::vector<std::byte> mData;
+    };
+
+    std::vector<std::byte> gzip(std::span<const std::byte> data) {
+        z_stream stream = {};
+        REQUIRE(deflateInit2(&stream, 1, Z_DEFLATED, GZIP_WINDOW_BITS, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+
+        std::vector<std::byte> compressed(deflateBound(&stream, data.size()));
+
+        stream.next_in = (Bytef *) data.data();
+        stream.avail_in = (uInt) data.size();
+        stream.next_out = (Bytef *) compressed.data();
+        stream.avail_out = (uInt) compressed.size();
+
+        REQUIRE(deflate(&stream, Z_FINISH) == Z_STREAM_END);
+        compressed.resize(stream.total_out);
+        deflateEnd(&stream);
+
+        return compressed;
+    }
+
+    class LayerFile {
+    public:
+        explicit LayerFile(std::span<const std::byte> content)
+                : mFile(content), mLayer(go::symbol::openLayer(mFile.path())) {
+
+        }
+
+    public:
+        explicit operator bool() const {
+            return mLayer.has_value();
+        }
+
+        const go::symbol::Layer *operator->() const {
+            return &*mLayer;
+        }
+
+        const go::symbol::Layer &operator*() const {
+            return *mLayer;
+        }
+
+    private:
+        fixture::TemporaryFile mFile;
+        std::optional<go::symbol::Layer> mLayer;
+    };
+
+    int minor(const go::symbol::Layer &layer, std::string_view name) {
+        std::optional<go::symbol::Reader> reader = layer.open(name);
+
+        if (!reader)
+            return -1;
+
+        std::optional<go::Version> version = reader->version();
+
+        if (!version)
+            return -1;
+
+        return version->minor;
+    }
+}
+
+TEST_CASE("layer tar formats", "[layer]") {
+    auto compressed = GENERATE(false, true);
+
+    auto content = [=](Archive &archive) {
+        std::vector<std::byte> data = archive.finish();
+        return compressed ? gzip(data) : data;
+    };
+
+    SECTION("ustar") {
+        Archive archive;
+        std::vector<std::byte> app = binary(20);
+
+        archive.header({"app", '0', app.size(), {}, "usr/local/bin"});
+        archive.data(app);
+        archive.file("./etc/app", binary(18));
+        archive.header({"usr/bin/app", '2', 0, "../local/bin/app"});
+        archive.header({"bin/app", '1', 0, "usr/local/bin/app"});
+
+        LayerFile layer(content(archive));
+        REQUIRE(layer);
+        REQUIRE(layer->compressed() == compressed);
+        REQUIRE(layer->entries().size() == 4);
+
+        REQUIRE(layer->find("usr/local/bin/app"));
+        REQUIRE(layer->find("/etc/app"));
+        REQUIRE(minor(*layer, "usr/local/bin/app") == 20);
+        REQUIRE(minor(*layer, "etc/app") == 18);
+        REQUIRE(minor(*layer, "usr/bin/app") == 20);
+        REQUIRE(minor(*layer, "bin/app") == 20);
+        REQUIRE(!layer->open("missing"));
+    }
+
+    SECTION("later entries replace earlier ones") {
+        Archive archive;
+
+        archive.file("app", binary(18));
+        archive.file("app", binary(21));
+
+        LayerFile layer(content(archive));
+        REQUIRE(layer);
+        REQUIRE(minor(*layer, "app") == 21);
+    }
+
+    SECTION("gnu long names") {
+        Archive archive;
+        std::string name = std::string(150, 'n') + "/app";
+        std::string link = std::string(120, 'l') + "/target";
+
+        archive.extended('L', name);
+        archive.file(name.substr(0, 99), binary(19));
+        archive.extended('L', link);
+        archive.file(link.substr(0, 99), binary(22));
+        archive.extended('L', "short/link");
+        archive.extended('K', link);
+        archive.header({"truncated", '1', 0, link.substr(0, 99)});
+
+        LayerFile layer(content(archive));
+        REQUIRE(layer);
+        REQUIRE(layer->find(name));
+        REQUIRE(!layer->find(name.substr(0, 99)));
+        REQUIRE(layer->find("short/link")->link == link);
+        REQUIRE(minor(*layer, name) == 19);
+        REQUIRE(minor(*layer, "short/link") == 22);
+    }
+
+    SECTION("pax headers") {
+        Archive archive;
+        std::string name = std::string(200, 'p') + "/app";
+        std::vector<std::byte> app = binary(23);
+
+        archive.pax({{"path", name}, {"size", std::to_string(app.size())}, {"mtime", "0.5"}});
+        archive.header({"short", '0', 0});
+        archive.data(app);
+
+        LayerFile layer(content(archive));
+        REQUIRE(layer);
+        REQUIRE(layer->find(name)->size == app.size());
+        REQUIRE(minor(*layer, name) == 23);
+    }
+
+    SECTION("invalid pax size") {
+        auto size = GENERATE(as<std::string>{}, "", "12a", "-1", "99999999999999999999999");
+        Archive archive;
+
+        archive.pax({{"size", size}});
+        archive.file("app", binary(20));
+
+        REQUIRE(!LayerFile(content(archive)));
+    }
+
+    SECTION("base-256 sizes") {
+        Archive archive;
+        std::vector<std::byte> app = binary(20);
+
+        archive.header({"app", '0', app.size(), {}, {}, true});
+        archive.data(app);
+
+        LayerFile layer(content(archive));
+        REQUIRE(layer);
+        REQUIRE(minor(*layer, "app") == 20);
+    }
+
+    SECTION("negative base-256 size") {
+        Archive archive;
+
+        archive.header({"app", '0', uint64_t(-1), {}, {}, true});
+
+        REQUIRE(!LayerFile(content(archive)));
+    }
+
+    SECTION("whiteouts") {
+        Archive archive;
+
+        archive.file("bin/app", binary(20));
+        archive.header({"bin/.wh.app"});
+        archive.header({"lib/.wh..wh..opq"});
+        archive.header({".wh.removed"});
+
+        LayerFile layer(content(archive));
+        REQUIRE(layer);
+        REQUIRE(layer->entries().size() == 1);
+        REQUIRE(minor(*layer, "bin/app") == 20);
+        REQUIRE(!layer->find("bin/.wh.app"));
+        REQUIRE(!layer->find("lib/.wh..wh..opq"));
+        REQUIRE(!layer->find(".wh.removed"));
+        REQUIRE(!layer->find("removed"));
+    }
+}
+
+TEST_CASE("compressed layer checkpoints", "[layer]") {
+    Archive archive;
+
+    archive.file("first", binary(18));
+
+    for (int i = 0; i < FILLER_COUNT; i++)
+        archive.file("filler" + std::to_string(i), filler(FILLER_SIZE, i + 1));
+
+    archive.file("last", binary(21));
+
+    std::vector<std::byte> data = archive.finish();
+
+    SECTION("single member") {
+        LayerFile layer(gzip(data));
+        REQUIRE(layer);
+        REQUIRE(layer->compressed());
+
+        REQUIRE(minor(*layer, "last") == 21);
+        REQUIRE(minor(*layer, "first") == 18);
+        REQUIRE(minor(*layer, "last") == 21);
+    }
+
+    SECTION("multiple members") {
+        size_t split = data.size() / 2;
+
+        std::vector<std::byte> compressed = gzip(std::span{data}.first(split));
+        std::vector<std::byte> tail = gzip(std::span{data}.subspan(split));
+
+        compressed.insert(compressed.end(), tail.begin(), tail.end());
+
+        LayerFile layer(compressed);
+        REQUIRE(layer);
+        REQUIRE(minor(*layer, "last") == 21);
+        REQUIRE(minor(*layer, "first") == 18);
+    }
+
+    SECTION("truncated stream") {
+        std::vector<std::byte> compressed = gzip(data);
+        compressed.resize(compressed.size() / 2);
+
+        REQUIRE(!LayerFile(compressed));
+    }
+}
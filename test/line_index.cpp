@@ -0,0 +1,86 @@
+#include "fixture.h"
+#include <go/symbol/line_index.h>
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+constexpr auto TEXT_START = 0x400000;
+constexpr auto MAIN_FILE = "/src/app/main.go";
+constexpr auto UTIL_FILE = "/src/app/util.go";
+
+namespace {
+    std::vector<std::byte> table() {
+        return fixture::pclntab(
+                {
+                        go::symbol::VERSION120,
+                        TEXT_START,
+                        {MAIN_FILE, UTIL_FILE},
+                        {
+                                {
+                                        "main.main",
+                                        0x00,
+                                        {
+                                                {0x10, 0, 10, 0},
+                                                {0x10, 0, 11, 0},
+                                                {0x10, 1, 5, 0},
+                                                {0x10, 0, 11, 0},
+                                                {0x10, 0, 12, 0}
+                                        },
+                                        0
+                                },
+                                {"main.helper", 0x50, {{0x20, 1, 5, 0}, {0x10, 1, 6, 0}}, 0},
+                                {"main.next", 0x80, {{0x10, 1, 6, 0}}, 0}
+                        }
+                }
+        );
+    }
+
+    bool equal(std::span<const go::symbol::PCRange> ranges, const std::vector<go::symbol::PCRange> &expected) {
+        return std::equal(ranges.begin(), ranges.end(), expected.begin(), expected.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.start == rhs.start && lhs.end == rhs.end;
+        });
+    }
+}
+
+TEST_CASE("file to line to pc lookup", "[line_index]") {
+    std::vector<std::byte> buffer = table();
+    go::symbol::SymbolTable symbolTable(go::symbol::VERSION120, go::endian::Converter(elf::endian::Little), buffer.data(), 0);
+    go::symbol::FileIndex files(&symbolTable);
+    go::symbol::LineIndex index(&symbolTable, &files);
+
+    REQUIRE(files.size() == 2);
+
+    std::optional<uint32_t> main = files.find(MAIN_FILE);
+    std::optional<uint32_t> util = files.find(UTIL_FILE);
+
+    REQUIRE(main);
+    REQUIRE(util);
+
+    SECTION("by file id") {
+        REQUIRE(equal(index.find(*main, 10), {{0x400000, 0x400010}}));
+        REQUIRE(equal(index.find(*main, 11), {{0x400010, 0x400020}, {0x400030, 0x400040}}));
+        REQUIRE(equal(index.find(*main, 12), {{0x400040, 0x400050}}));
+        REQUIRE(equal(index.find(*util, 5), {{0x400020, 0x400030}, {0x400050, 0x400070}}));
+        REQUIRE(index.find(*main, 13).empty());
+    }
+
+    SECTION("adjacent ranges across functions are merged") {
+        REQUIRE(equal(index.find(*util, 6), {{0x400070, 0x400090}}));
+    }
+
+    SECTION("by path suffix") {
+        REQUIRE(equal(index.find("main.go", 11), {{0x400010, 0x400020}, {0x400030, 0x400040}}));
+        REQUIRE(equal(index.find("app/util.go", 5), {{0x400020, 0x400030}, {0x400050, 0x400070}}));
+        REQUIRE(equal(index.find(UTIL_FILE, 6), {{0x400070, 0x400090}}));
+        REQUIRE(index.find("in.go", 11).empty());
+        REQUIRE(index.find("other.go", 11).empty());
+    }
+
+    SECTION("file id out of range") {
+        REQUIRE(index.find(uint32_t(files.size()), 10).empty());
+        REQUIRE(index.find(UINT32_MAX, 10).empty());
+    }
+}
@@ -0,0 +1,160 @@
+#include "fixture.h"
+#include <go/symbol/reader.h>
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+constexpr auto TEXT_ADDRESS = 0x1000;
+constexpr auto SYMBOL_ADDRESS = 0x2000;
+constexpr auto DATA_ADDRESS = 0x10000;
+constexpr auto MODULE_ADDRESS = 0x20000;
+constexpr auto DYNAMIC_ADDRESS = 0x30000;
+
+constexpr auto BUILD_INFO_MAGIC = "\xff Go buildinf:";
+constexpr auto BUILD_INFO_VERSION = "go1.20";
+constexpr auto POINTER_FREE_FLAG = 0x2;
+
+constexpr auto TYPES_OFFSET = 0x40;
+constexpr auto TYPE_LINKS_OFFSET = 0x100;
+constexpr auto RELA_OFFSET = 0x200;
+constexpr auto RTYPE_SIZE = 48;
+
+constexpr auto MODULE_OFFSET = 0x40;
+constexpr auto MODULE_WORDS = 50;
+constexpr auto MODULE_FUNC_NAME_TABLE = 1;
+constexpr auto MODULE_TYPES = 37;
+constexpr auto MODULE_TYPE_LINKS = 44;
+
+namespace {
+    struct Word {
+        int index;
+        uint64_t value;
+    };
+
+    std::vector<std::byte> image(bool pie, bool relocate) {
+        std::vector<std::byte> symbols = fixture::pclntab(
+                {
+                        go::symbol::VERSION120,
+                        TEXT_ADDRESS,
+                        {"main.go"},
+                        {{"main.main", 0, {{0x10, 0, 1, 0}}, 0}}
+                }
+        );
+
+        std::vector<std::byte> data;
+
+        fixture::append(data, BUILD_INFO_MAGIC);
+        fixture::put(data, 14, 8, 1);
+        fixture::put(data, 15, POINTER_FREE_FLAG, 1);
+        data.resize(32);
+        fixture::uVarInt(data, std::string_view{BUILD_INFO_VERSION}.size());
+        fixture::append(data, BUILD_INFO_VERSION);
+        fixture::uVarInt(data, 0);
+
+        uint32_t name = TYPES_OFFSET + RTYPE_SIZE;
+
+        fixture::put(data, TYPES_OFFSET, 8, 8);
+        fixture::put(data, TYPES_OFFSET + 23, go::symbol::IntKind, 1);
+        fixture::put(data, TYPES_OFFSET + 40, name - TYPES_OFFSET, 4);
+        fixture::put(data, name, 0, 1);
+        fixture::put(data, name + 1, 3, 1);
+        data.resize(name + 2);
+        fixture::append(data, "int");
+
+        fixture::put(data, TYPE_LINKS_OFFSET, 0, 4);
+
+        uint64_t funcNameTable = SYMBOL_ADDRESS + std::to_integer<uint64_t>(symbols[32]);
+
+        std::vector<Word> pointers = {
+                {0,                     SYMBOL_ADDRESS},
+                {MODULE_FUNC_NAME_TABLE, funcNameTable},
+                {MODULE_TYPES,          DATA_ADDRESS + TYPES_OFFSET},
+                {MODULE_TYPES + 1,      DATA_ADDRESS + TYPE_LINKS_OFFSET},
+                {MODULE_TYPE_LINKS,     DATA_ADDRESS + TYPE_LINKS_OFFSET}
+        };
+
+        std::vector<std::byte> module(MODULE_OFFSET + MODULE_WORDS * 8);
+
+        fixture::put(module, MODULE_OFFSET + (MODULE_TYPE_LINKS + 1) * 8, 1, 8);
+        fixture::put(module, MODULE_OFFSET + (MODULE_TYPE_LINKS + 2) * 8, 1, 8);
+
+        size_t rela = RELA_OFFSET;
+
+        for (const auto &pointer: pointers) {
+            uint64_t offset = MODULE_OFFSET + pointer.index * 8;
+
+            if (!pie) {
+                fixture::put(module, offset, pointer.value, 8);
+                continue;
+            }
+
+            fixture::put(data, rela, MODULE_ADDRESS + offset, 8);
+            fixture::put(data, rela + 8, R_X86_64_RELATIVE, 8);
+            fixture::put(data, rela + 16, pointer.value, 8);
+
+            rela += 24;
+        }
+
+        std::vector<std::byte> dynamic;
+
+        if (relocate) {
+            fixture::append(dynamic, DT_RELA, 8);
+            fixture::append(dynamic, DATA_ADDRESS + RELA_OFFSET, 8);
+            fixture::append(dynamic, DT_RELASZ, 8);
+            fixture::append(dynamic, rela - RELA_OFFSET, 8);
+            fixture::append(dynamic, DT_RELAENT, 8);
+            fixture::append(dynamic, 24, 8);
+        }
+
+        fixture::append(dynamic, DT_NULL, 8);
+        fixture::append(dynamic, 0, 8);
+
+        return fixture::elf(
+                {
+                        uint16_t(pie ? ET_DYN : ET_EXEC),
+                        {
+                                {SYMBOL_ADDRESS, symbols},
+                                {DATA_ADDRESS, data},
+                                {MODULE_ADDRESS, module, PT_LOAD, PF_R | PF_W},
+                                {DYNAMIC_ADDRESS, dynamic, PT_DYNAMIC, PF_R | PF_W}
+                        },
+                        {}
+                }
+        );
+    }
+
+    std::optional<go::symbol::TypeTable> types(const std::vector<std::byte> &content) {
+        fixture::TemporaryFile file(content);
+        std::optional<go::symbol::Reader> reader = go::symbol::openFile(file.path());
+
+        if (!reader)
+            return std::nullopt;
+
+        return reader->types();
+    }
+}
+
+TEST_CASE("module data location", "[locate]") {
+    SECTION("pointers present on disk") {
+        std::optional<go::symbol::TypeTable> table = types(image(false, false));
+
+        REQUIRE(table);
+        REQUIRE(table->size() == 1);
+        REQUIRE(table->operator[](0)->name == "int");
+    }
+
+    SECTION("pointers resolved through relative relocations") {
+        std::optional<go::symbol::TypeTable> table = types(image(true, true));
+
+        REQUIRE(table);
+        REQUIRE(table->size() == 1);
+        REQUIRE(table->operator[](0)->name == "int");
+    }
+
+    SECTION("zeroed pointers without relocations") {
+        REQUIRE(!types(image(true, false)));
+    }
+}
@@ -0,0 +1,110 @@
+#include "fixture.h"
+#include <go/symbol/name_index.h>
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+constexpr auto TEXT_START = 0x400000;
+constexpr auto FUNCTION_SIZE = 0x10;
+
+namespace {
+    struct Expectation {
+        std::string function;
+        std::string_view package;
+        std::string_view receiver;
+        std::string_view method;
+        std::string_view generic;
+    };
+
+    const std::vector<Expectation> &expectations() {
+        static const std::vector<Expectation> expectations = {
+                {"main.main", "main", "", "main", ""},
+                {"main.main.func1", "main", "", "main", ""},
+                {"main.main.gowrap2", "main", "", "main", ""},
+                {"main.(*Server).Serve", "main", "*Server", "Serve", ""},
+                {"main.(*Server).Serve.deferwrap1", "main", "*Server", "Serve", ""},
+                {"main.Server.String", "main", "Server", "String", ""},
+                {"main.Map[go.shape.int,go.shape.string]", "main", "", "Map", "[go.shape.int,go.shape.string]"},
+                {"main.(*List[...]).Push", "main", "*List", "Push", "[...]"},
+                {"main.List[...].Len", "main", "List", "Len", "[...]"},
+                {"net/http.(*conn).serve", "net/http", "*conn", "serve", ""},
+                {"net/http.HandlerFunc.ServeHTTP", "net/http", "HandlerFunc", "ServeHTTP", ""},
+                {
+                        "vendor/golang.org/x/net/http2/hpack.(*Encoder).WriteField",
+                        "vendor/golang.org/x/net/http2/hpack",
+                        "*Encoder",
+                        "WriteField",
+                        ""
+                },
+                {"gopkg.in/yaml%2ev3.(*decoder).unmarshal", "gopkg.in/yaml%2ev3", "*decoder", "unmarshal", ""},
+                {"github.com/a.b/c.Func", "github.com/a.b/c", "", "Func", ""},
+                {"go:buildid", "", "", "go:buildid", ""}
+        };
+
+        return expectations;
+    }
+
+    std::vector<std::byte> table() {
+        fixture::Table table = {go::symbol::VERSION120, TEXT_START, {"main.go"}, {}};
+
+        for (size_t i = 0; i < expectations().size(); i++)
+            table.functions.push_back({expectations()[i].function, uint32_t(i * FUNCTION_SIZE), {{FUNCTION_SIZE, 0, 1, 0}}, 0});
+
+        return fixture::pclntab(table);
+    }
+}
+
+TEST_CASE("function name components", "[name_index]") {
+    std::vector<std::byte> buffer = table();
+    go::symbol::SymbolTable symbolTable(go::symbol::VERSION120, go::endian::Converter(elf::endian::Little), buffer.data(), 0);
+
+    auto threads = GENERATE(1, 4);
+    go::symbol::NameIndex index(&symbolTable, threads);
+
+    REQUIRE(index.size() == expectations().size());
+
+    SECTION("package, receiver, method and generic split") {
+        for (size_t i = 0; i < expectations().size(); i++) {
+            const Expectation &expectation = expectations()[i];
+            const go::symbol::NameComponents &components = index[i];
+
+            INFO(expectation.function);
+
+            REQUIRE(index.string(go::symbol::FunctionNameSpace, components.function) == expectation.function);
+            REQUIRE(index.string(go::symbol::PackageNameSpace, components.package) == expectation.package);
+            REQUIRE(index.string(go::symbol::ReceiverNameSpace, components.receiver) == expectation.receiver);
+            REQUIRE(index.string(go::symbol::MethodNameSpace, components.method) == expectation.method);
+            REQUIRE(index.string(go::symbol::GenericNameSpace, components.generic) == expectation.generic);
+        }
+    }
+
+    SECTION("components are interned") {
+        REQUIRE(index.find(go::symbol::PackageNameSpace, "") == 0);
+        REQUIRE(index.find(go::symbol::PackageNameSpace, "main") == index[0].package);
+        REQUIRE(index[3].receiver == index[4].receiver);
+        REQUIRE(index[7].generic == index[8].generic);
+        REQUIRE(index[0].method == index[1].method);
+        REQUIRE(index.find(go::symbol::MethodNameSpace, "missing") == std::nullopt);
+        REQUIRE(index.poolID(go::symbol::MethodNameSpace, index[0].method) == std::nullopt);
+    }
+}
+
+TEST_CASE("pooled function name components", "[name_index]") {
+    std::vector<std::byte> buffer = table();
+    go::symbol::SymbolTable symbolTable(go::symbol::VERSION120, go::endian::Converter(elf::endian::Little), buffer.data(), 0);
+    go::symbol::StringPool pool;
+
+    {
+        go::symbol::NameIndex index(&symbolTable, 1, &pool);
+        std::optional<uint32_t> id = index.poolID(go::symbol::ReceiverNameSpace, index[3].receiver);
+
+        REQUIRE(id);
+        REQUIRE(pool.string(*id) == "*Server");
+    }
+
+    REQUIRE(pool.usage().strings == 0);
+}
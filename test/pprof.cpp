@@ -0,0 +1,348 @@
+#include "fixture.h"
+#include <go/symbol/pprof.h>
+#include <zlib.h>
+#include <map>
+#include <set>
+#include <sstream>
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+constexpr auto TEXT_START = 0x400000;
+constexpr auto FUNCTION_COUNT = 3;
+constexpr auto FUNCTION_SIZE = 0x40;
+constexpr auto LINE_STEP = 0x10;
+constexpr auto START_LINE = 30;
+constexpr auto SOURCE_FILE = "/src/app/main.go";
+
+namespace {
+    struct Field {
+        uint64_t number;
+        uint64_t value;
+        std::string_view bytes;
+    };
+
+    uint64_t varint(std::string_view &data) {
+        uint64_t value = 0;
+
+        for (int shift = 0; shift < 64; shift += 7) {
+            REQUIRE(!data.empty());
+
+            auto byte = uint8_t(data.front());
+            data.remove_prefix(1);
+
+            value |= uint64_t(byte & 0x7f) << shift;
+
+            if (!(byte & 0x80))
+                return value;
+        }
+
+        FAIL("varint overflow");
+        return 0;
+    }
+
+    std::vector<Field> decode(std::string_view data) {
+        std::vector<Field> fields;
+
+        while (!data.empty()) {
+            uint64_t key = varint(data);
+            Field field = {key >> 3, 0, {}};
+
+            if ((key & 7) == 0) {
+                field.value = varint(data);
+            } else {
+                REQUIRE((key & 7) == 2);
+
+                uint64_t length = varint(data);
+                REQUIRE(length <= data.size());
+
+                field.bytes = data.substr(0, length);
+                data.remove_prefix(length);
+            }
+
+            fields.push_back(field);
+        }
+
+        return fields;
+    }
+
+    std::vector<uint64_t> packed(std::string_view data) {
+        std::vector<uint64_t> values;
+
+        while (!data.empty())
+            values.push_back(varint(data));
+
+        return values;
+    }
+
+    std::map<uint64_t, uint64_t> scalars(std::string_view data) {
+        std::map<uint64_t, uint64_t> values;
+
+        for (const auto &field: decode(data))
+            values[field.number] = field.value;
+
+        return values;
+    }
+
+    struct Profile {
+        std::vector<std::string> strings;
+        std::vector<std::pair<uint64_t, uint64_t>> sampleTypes;
+        std::pair<uint64_t, uint64_t> periodType;
+        uint64_t period;
+        std::vector<std::pair<std::vector<uint64_t>, std::vector<uint64_t>>> samples;
+        std::map<uint64_t, std::string_view> locations;
+        std::map<uint64_t, std::map<uint64_t, uint64_t>> functions;
+    };
+
+    Profile parse(std::string_view data) {
+        Profile profile = {};
+
+        for (const auto &field: decode(data)) {
+            switch (field.number) {
+                case 1: {
+                    std::map<uint64_t, uint64_t> values = scalars(field.bytes);
+                    profile.sampleTypes.emplace_back(values[1], values[2]);
+                    break;
+                }
+
+                case 2: {
+                    std::vector<uint64_t> locations;
+                    std::vector<uint64_t> values;
+
+                    for (const auto &sample: decode(field.bytes)) {
+                        if (sample.number == 1)
+                            locations = packed(sample.bytes);
+                        else if (sample.number == 2)
+                            values = packed(sample.bytes);
+                    }
+
+                    profile.samples.emplace_back(locations, values);
+                    break;
+                }
+
+                case 4: {
+                    std::map<uint64_t, uint64_t> values = scalars(field.bytes);
+
+                    REQUIRE(!profile.locations.contains(values[1]));
+                    profile.locations[values[1]] = field.bytes;
+
+                    break;
+                }
+
+                case 5: {
+                    std::map<uint64_t, uint64_t> values = scalars(field.bytes);
+
+                    REQUIRE(!profile.functions.contains(values[1]));
+                    profile.functions[values[1]] = values;
+
+                    break;
+                }
+
+                case 6:
+                    profile.strings.emplace_back(field.bytes);
+                    break;
+
+                case 11: {
+                    std::map<uint64_t, uint64_t> values = scalars(field.bytes);
+                    profile.periodType = {values[1], values[2]};
+                    break;
+                }
+
+                case 12:
+                    profile.period = field.value;
+                    break;
+
+                default:
+                    FAIL("unexpected profile field " << field.number);
+            }
+        }
+
+        return profile;
+    }
+
+    std::string inflate(const std::string &compressed) {
+        z_stream stream = {};
+        REQUIRE(inflateInit2(&stream, 15 + 16) == Z_OK);
+
+        std::string output;
+        char buffer[4096];
+
+        stream.next_in = (Bytef *) compressed.data();
+        stream.avail_in = compressed.size();
+
+        int status;
+
+        do {
+            stream.next_out = (Bytef *) buffer;
+            stream.avail_out = sizeof(buffer);
+
+            status = ::inflate(&stream, Z_NO_FLUSH);
+            REQUIRE((status == Z_OK || status == Z_STREAM_END));
+
+            output.append(buffer, sizeof(buffer) - stream.avail_out);
+        } while (status != Z_STREAM_END);
+
+        inflateEnd(&stream);
+        return output;
+    }
+
+    std::string name(size_t index) {
+        return "main.function" + std::to_string(index);
+    }
+
+    uint64_t pc(size_t index, size_t step) {
+        return TEXT_START + index * FUNCTION_SIZE + step * LINE_STEP + 4;
+    }
+
+    std::vector<std::byte> table() {
+        fixture::Table table = {go::symbol::VERSION120, TEXT_START, {SOURCE_FILE}, {}};
+
+        for (size_t i = 0; i < FUNCTION_COUNT; i++) {
+            fixture::Function function = {name(i), uint32_t(i * FUNCTION_SIZE), {}, 0};
+
+            for (size_t step = 0; step < FUNCTION_SIZE / LINE_STEP; step++)
+                function.steps.push_back({LINE_STEP, 0, START_LINE + int(i * 10 + step), 0});
+
+            table.functions.push_back(std::move(function));
+        }
+
+        return fixture::pclntab(table);
+    }
+
+    std::string write(const go::symbol::SymbolTable &table, bool compress) {
+        std::ostringstream stream;
+        go::symbol::ProfileWriter writer(&table, stream, compress);
+
+        std::vector<uint64_t> unknown = {TEXT_START + FUNCTION_COUNT * FUNCTION_SIZE + 8, pc(0, 0)};
+
+        REQUIRE(writer.sampleType("samples", "count"));
+        REQUIRE(writer.sampleType("cpu", "nanoseconds"));
+        REQUIRE(writer.period("cpu", "nanoseconds", 10000000));
+        REQUIRE(writer.sample(std::vector<uint64_t>{pc(2, 1), pc(1, 3), pc(0, 0)}, std::vector<int64_t>{1, 10000000}));
+        REQUIRE(writer.sample(std::vector<uint64_t>{pc(2, 2), pc(1, 3), pc(0, 0)}, std::vector<int64_t>{2, -1}));
+        REQUIRE(writer.sample(unknown, std::vector<int64_t>{3, 0}));
+        REQUIRE(writer.finish());
+        REQUIRE(!writer.finish());
+
+        return stream.str();
+    }
+}
+
+TEST_CASE("pprof profile encoding", "[pprof]") {
+    std::vector<std::byte> buffer = table();
+    go::symbol::SymbolTable symbolTable(go::symbol::VERSION120, go::endian::Converter(elf::endian::Little), buffer.data(), 0);
+
+    std::string raw = write(symbolTable, false);
+    Profile profile = parse(raw);
+
+    auto string = [&](uint64_t id) -> const std::string & {
+        REQUIRE(id < profile.strings.size());
+        return profile.strings[id];
+    };
+
+    SECTION("string table") {
+        REQUIRE(!profile.strings.empty());
+        REQUIRE(profile.strings[0].empty());
+
+        std::set<std::string> unique(profile.strings.begin(), profile.strings.end());
+        REQUIRE(unique.size() == profile.strings.size());
+    }
+
+    SECTION("value types") {
+        REQUIRE(profile.sampleTypes.size() == 2);
+        REQUIRE(string(profile.sampleTypes[0].first) == "samples");
+        REQUIRE(string(profile.sampleTypes[0].second) == "count");
+        REQUIRE(string(profile.sampleTypes[1].first) == "cpu");
+        REQUIRE(string(profile.sampleTypes[1].second) == "nanoseconds");
+        REQUIRE(string(profile.periodType.first) == "cpu");
+        REQUIRE(string(profile.periodType.second) == "nanoseconds");
+        REQUIRE(profile.period == 10000000);
+    }
+
+    SECTION("locations are deduplicated by pc") {
+        REQUIRE(profile.locations.size() == 5);
+
+        std::map<uint64_t, uint64_t> addresses;
+
+        for (const auto &[id, record]: profile.locations)
+            addresses[scalars(record)[3]] = id;
+
+        REQUIRE(addresses.size() == 5);
+
+        for (size_t i = 0; i < profile.samples.size(); i++) {
+            for (const auto &id: profile.samples[i].first)
+                REQUIRE(profile.locations.contains(id));
+        }
+
+        REQUIRE(profile.samples.size() == 3);
+        REQUIRE(profile.samples[0].first == std::vector<uint64_t>{addresses[pc(2, 1)], addresses[pc(1, 3)], addresses[pc(0, 0)]});
+        REQUIRE(profile.samples[1].first == std::vector<uint64_t>{addresses[pc(2, 2)], addresses[pc(1, 3)], addresses[pc(0, 0)]});
+        REQUIRE(profile.samples[2].first[1] == addresses[pc(0, 0)]);
+    }
+
+    SECTION("sample values") {
+        REQUIRE(profile.samples[0].second == std::vector<uint64_t>{1, 10000000});
+        REQUIRE(profile.samples[1].second == std::vector<uint64_t>{2, uint64_t(-1)});
+        REQUIRE(profile.samples[2].second == std::vector<uint64_t>{3, 0});
+    }
+
+    SECTION("location lines reference functions") {
+        for (size_t index = 0; index < FUNCTION_COUNT; index++) {
+            for (size_t step = 0; step < FUNCTION_SIZE / LINE_STEP; step++) {
+                auto it = std::find_if(profile.locations.begin(), profile.locations.end(), [&](const auto &location) {
+                    return scalars(location.second)[3] == pc(index, step);
+                });
+
+                if (it == profile.locations.end())
+                    continue;
+
+                std::vector<Field> fields = decode(it->second);
+                auto line = std::find_if(fields.begin(), fields.end(), [](const auto &field) {
+                    return field.number == 4;
+                });
+
+                REQUIRE(line != fields.end());
+
+                std::map<uint64_t, uint64_t> values = scalars(line->bytes);
+
+                REQUIRE(values[2] == START_LINE + index * 10 + step);
+                REQUIRE(profile.functions.contains(values[1]));
+                REQUIRE(string(profile.functions[values[1]][2]) == name(index));
+            }
+        }
+
+        auto unknown = std::find_if(profile.locations.begin(), profile.locations.end(), [](const auto &location) {
+            return scalars(location.second)[3] == TEXT_START + FUNCTION_COUNT * FUNCTION_SIZE + 8;
+        });
+
+        REQUIRE(unknown != profile.locations.end());
+
+        for (const auto &field: decode(unknown->second))
+            REQUIRE(field.number != 4);
+    }
+
+    SECTION("functions") {
+        REQUIRE(profile.functions.size() == FUNCTION_COUNT);
+
+        for (const auto &[id, values]: profile.functions) {
+            size_t index = id - 1;
+
+            REQUIRE(string(values.at(2)) == name(index));
+            REQUIRE(string(values.at(3)) == name(index));
+            REQUIRE(string(values.at(4)) == SOURCE_FILE);
+            REQUIRE(values.at(5) == START_LINE + index * 10);
+        }
+    }
+
+    SECTION("gzip output decompresses to the raw encoding") {
+        std::string compressed = write(symbolTable, true);
+
+        REQUIRE(compressed.size() > 2);
+        REQUIRE(uint8_t(compressed[0]) == 0x1f);
+        REQUIRE(uint8_t(compressed[1]) == 0x8b);
+        REQUIRE(inflate(compressed) == raw);
+    }
+}
@@ -0,0 +1,97 @@
+#include "fixture.h"
+#include <go/symbol/reader.h>
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+constexpr auto TEXT_START = 0x400000;
+constexpr auto SECTION_ADDRESS = 0x800000;
+constexpr auto LOAD_ADDRESS = 0x1000;
+
+constexpr auto FUNCTION_COUNT = 1000;
+constexpr auto FUNCTION_ALIGN = 16;
+constexpr auto GAP_INTERVAL = 97;
+constexpr auto GAP_SIZE = 0x100000;
+
+namespace {
+    std::vector<std::byte> table(go::symbol::SymbolVersion version) {
+        fixture::Table table = {version, TEXT_START, {"main.go"}, {}};
+        uint32_t entry = 0;
+
+        for (size_t i = 0; i < FUNCTION_COUNT; i++) {
+            auto size = uint32_t(FUNCTION_ALIGN * (1 + i * 7919 % 37));
+
+            if (i % GAP_INTERVAL == GAP_INTERVAL - 1)
+                entry += GAP_SIZE;
+
+            table.functions.push_back({"main.function" + std::to_string(i), entry, {{size, 0, int(i + 1), 0}}, 0});
+            entry += size;
+        }
+
+        return fixture::pclntab(table);
+    }
+
+    std::vector<std::byte> image(const std::vector<std::byte> &data) {
+        return fixture::elf(
+                {
+                        ET_EXEC,
+                        {{LOAD_ADDRESS, std::vector<std::byte>(16)}},
+                        {{".gopclntab", SHT_PROGBITS, SHF_ALLOC, SECTION_ADDRESS, data}}
+                }
+        );
+    }
+}
+
+TEST_CASE("packed function table", "[seek]") {
+    auto version = GENERATE(go::symbol::VERSION118, go::symbol::VERSION120);
+    std::vector<std::byte> data = table(version);
+
+    go::symbol::SymbolTable expected(version, go::endian::Converter(elf::endian::Little), data.data(), 0);
+
+    SECTION("lookups match the unpacked table") {
+        fixture::TemporaryFile file(image(data));
+        std::optional<go::symbol::Reader> reader = go::symbol::openFile(file.path());
+        REQUIRE(reader);
+
+        std::optional<go::symbol::seek::SymbolTable> table = reader->symbols();
+        REQUIRE(table);
+        REQUIRE(table->valid());
+        REQUIRE(table->size() == expected.size());
+
+        for (size_t i = 0; i < expected.size(); i++) {
+            uint64_t entry = expected[i].entry();
+            uint64_t end = i + 1 < expected.size() ? expected[i + 1].entry() : entry + FUNCTION_ALIGN;
+
+            REQUIRE(table->operator[](i).entry() == entry);
+
+            for (uint64_t pc: {entry, entry + (end - entry) / 2, end - 1}) {
+                auto it = table->find(pc);
+                bool found = it != table->end();
+
+                REQUIRE(found);
+                REQUIRE((*it).entry() == entry);
+                REQUIRE((*it).symbol().name() == expected[i].symbol().name());
+            }
+        }
+
+        bool before = table->find(expected[0].entry() - 1) == table->end();
+        bool after = table->find(TEXT_START + 0x10000000) == table->end();
+
+        REQUIRE(before);
+        REQUIRE(after);
+    }
+
+    SECTION("truncated function table") {
+        fixture::put(data, 8, 0x10000000, 8);
+
+        fixture::TemporaryFile file(image(data));
+        std::optional<go::symbol::Reader> reader = go::symbol::openFile(file.path());
+        REQUIRE(reader);
+
+        REQUIRE(!reader->symbols());
+    }
+}
@@ -0,0 +1,159 @@
+#include "fixture.h"
+#include <go/symbol/signal_safe.h>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <csignal>
+#include <sys/time.h>
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+constexpr auto TEXT_START = 0x400000;
+constexpr auto FUNCTION_COUNT = 64;
+constexpr auto FUNCTION_SIZE = 0x100;
+constexpr auto LINE_STEP = 0x10;
+constexpr auto START_LINE = 10;
+constexpr auto SOURCE_FILE = "main.go";
+
+constexpr auto SIGNAL_HITS = 500;
+constexpr auto SIGNAL_INTERVAL = std::chrono::microseconds{200};
+constexpr auto SIGNAL_TIMEOUT = std::chrono::seconds{10};
+
+namespace {
+    std::string name(size_t index) {
+        return "main.function" + std::to_string(index);
+    }
+
+    int line(uint64_t pc) {
+        return START_LINE + int((pc - TEXT_START) % FUNCTION_SIZE / LINE_STEP);
+    }
+
+    std::vector<std::byte> table() {
+        fixture::Table table = {go::symbol::VERSION120, TEXT_START, {SOURCE_FILE}, {}};
+
+        for (size_t i = 0; i < FUNCTION_COUNT; i++) {
+            fixture::Function function = {name(i), uint32_t(i * FUNCTION_SIZE), {}, 0};
+
+            for (int pc = 0; pc < FUNCTION_SIZE; pc += LINE_STEP)
+                function.steps.push_back({LINE_STEP, 0, line(TEXT_START + pc), 0});
+
+            table.functions.push_back(std::move(function));
+        }
+
+        return fixture::pclntab(table);
+    }
+
+    struct SignalState {
+        const go::symbol::SignalSafeSymbolizer *symbolizer;
+        const std::vector<std::string> *names;
+        std::atomic<size_t> hits;
+        std::atomic<size_t> failures;
+    };
+
+    SignalState state;
+
+    bool check(const go::symbol::SignalSafeSymbolizer &symbolizer, const std::vector<std::string> &names, uint64_t pc) {
+        go::symbol::Frame frame = {};
+
+        if (!symbolizer.symbolize(pc, frame))
+            return false;
+
+        size_t index = (pc - TEXT_START) / FUNCTION_SIZE;
+
+        if (frame.entry != TEXT_START + index * FUNCTION_SIZE || frame.line != line(pc))
+            return false;
+
+        if (!frame.name || strcmp(frame.name, names[index].c_str()) != 0)
+            return false;
+
+        if (!frame.file || strcmp(frame.file, SOURCE_FILE) != 0)
+            return false;
+
+        char buffer[128];
+        return go::symbol::SignalSafeSymbolizer::format(frame, buffer) > 0;
+    }
+
+    void handler(int) {
+        int error = errno;
+        size_t n = state.hits.fetch_add(1, std::memory_order_relaxed);
+        uint64_t pc = TEXT_START + n * 37 % (FUNCTION_COUNT * FUNCTION_SIZE);
+
+        if (!check(*state.symbolizer, *state.names, pc))
+            state.failures.fetch_add(1, std::memory_order_relaxed);
+
+        errno = error;
+    }
+}
+
+TEST_CASE("signal safe symbolization", "[signal_safe]") {
+    std::vector<std::byte> buffer = table();
+    go::symbol::SymbolTable symbolTable(go::symbol::VERSION120, go::endian::Converter(elf::endian::Little), buffer.data(), 0);
+    go::symbol::SignalSafeSymbolizer symbolizer(&symbolTable);
+
+    std::vector<std::string> names;
+
+    for (size_t i = 0; i < FUNCTION_COUNT; i++)
+        names.push_back(name(i));
+
+    SECTION("lookup") {
+        for (uint64_t pc = TEXT_START; pc < TEXT_START + FUNCTION_COUNT * FUNCTION_SIZE; pc += 7)
+            REQUIRE(check(symbolizer, names, pc));
+
+        go::symbol::Frame frame = {};
+
+        REQUIRE(!symbolizer.symbolize(TEXT_START - 1, frame));
+        REQUIRE(!symbolizer.symbolize(TEXT_START + FUNCTION_COUNT * FUNCTION_SIZE, frame));
+        REQUIRE(frame.name == nullptr);
+    }
+
+    SECTION("SIGPROF handler under load") {
+        state.symbolizer = &symbolizer;
+        state.names = &names;
+        state.hits = 0;
+        state.failures = 0;
+
+        struct sigaction action = {};
+        struct sigaction previous = {};
+
+        action.sa_handler = handler;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+
+        REQUIRE(sigaction(SIGPROF, &action, &previous) == 0);
+
+        itimerval timer = {};
+        timer.it_interval.tv_usec = SIGNAL_INTERVAL.count();
+        timer.it_value.tv_usec = SIGNAL_INTERVAL.count();
+
+        REQUIRE(setitimer(ITIMER_PROF, &timer, nullptr) == 0);
+
+        size_t iterations = 0;
+        size_t mismatches = 0;
+        auto deadline = std::chrono::steady_clock::now() + SIGNAL_TIMEOUT;
+
+        while (state.hits.load(std::memory_order_relaxed) < SIGNAL_HITS && std::chrono::steady_clock::now() < deadline) {
+            std::vector<std::string> garbage;
+
+            for (size_t i = 0; i < 64; i++)
+                garbage.push_back(names[(iterations + i) % names.size()] + std::to_string(i));
+
+            uint64_t pc = TEXT_START + iterations++ * 13 % (FUNCTION_COUNT * FUNCTION_SIZE);
+
+            if (!check(symbolizer, names, pc))
+                mismatches++;
+        }
+
+        timer = {};
+        setitimer(ITIMER_PROF, &timer, nullptr);
+        sigaction(SIGPROF, &previous, nullptr);
+
+        REQUIRE(mismatches == 0);
+        REQUIRE(state.hits >= SIGNAL_HITS);
+        REQUIRE(state.failures == 0);
+    }
+}
@@ -0,0 +1,159 @@
+#include "fixture.h"
+#include <go/symbol/stack.h>
+#include <cstring>
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+constexpr auto TEXT_START = 0x400000;
+constexpr auto FUNCTION_COUNT = 4;
+constexpr auto FUNCTION_SIZE = 0x40;
+constexpr auto LINE_STEP = 0x10;
+constexpr auto START_LINE = 20;
+constexpr auto SOURCE_FILE = "main.go";
+
+namespace {
+    std::string name(size_t index) {
+        return "main.function" + std::to_string(index);
+    }
+
+    uint64_t pc(size_t index, size_t step) {
+        return TEXT_START + index * FUNCTION_SIZE + step * LINE_STEP + 1;
+    }
+
+    int line(size_t step) {
+        return START_LINE + int(step);
+    }
+
+    std::vector<std::byte> table() {
+        fixture::Table table = {go::symbol::VERSION120, TEXT_START, {SOURCE_FILE}, {}};
+
+        for (size_t i = 0; i < FUNCTION_COUNT; i++) {
+            fixture::Function function = {name(i), uint32_t(i * FUNCTION_SIZE), {}, 0};
+
+            for (size_t step = 0; step < FUNCTION_SIZE / LINE_STEP; step++)
+                function.steps.push_back({LINE_STEP, 0, line(step), 0});
+
+            table.functions.push_back(std::move(function));
+        }
+
+        return fixture::pclntab(table);
+    }
+
+    std::vector<uint64_t> pcs(const go::symbol::StackSymbolizer &symbolizer, uint32_t id) {
+        std::vector<uint64_t> result;
+
+        for (const auto &frame: symbolizer.stack(id))
+            result.push_back(symbolizer.frame(frame).pc);
+
+        return result;
+    }
+}
+
+TEST_CASE("stack trie interning", "[stack]") {
+    std::vector<std::byte> buffer = table();
+    go::symbol::SymbolTable symbolTable(go::symbol::VERSION120, go::endian::Converter(elf::endian::Little), buffer.data(), 0);
+    go::symbol::StackSymbolizer symbolizer(&symbolTable);
+
+    std::vector<uint64_t> first = {pc(3, 0), pc(1, 2), pc(0, 1)};
+    std::vector<uint64_t> second = {pc(2, 3), pc(1, 2), pc(0, 1)};
+    std::vector<uint64_t> prefix = {pc(1, 2), pc(0, 1)};
+
+    uint32_t a = symbolizer.add(first);
+    uint32_t b = symbolizer.add(second);
+    uint32_t c = symbolizer.add(prefix);
+
+    SECTION("identical stacks share a node") {
+        REQUIRE(symbolizer.add(first) == a);
+        REQUIRE(symbolizer.add(second) == b);
+        REQUIRE(symbolizer.add(prefix) == c);
+        REQUIRE(a != b);
+        REQUIRE(a != c);
+        REQUIRE(b != c);
+    }
+
+    SECTION("frames are deduplicated by pc") {
+        REQUIRE(symbolizer.size() == 4);
+
+        std::vector<uint32_t> lhs = symbolizer.stack(a);
+        std::vector<uint32_t> rhs = symbolizer.stack(b);
+
+        REQUIRE(lhs.size() == 3);
+        REQUIRE(rhs.size() == 3);
+        REQUIRE(lhs[0] != rhs[0]);
+        REQUIRE(lhs[1] == rhs[1]);
+        REQUIRE(lhs[2] == rhs[2]);
+        REQUIRE(symbolizer.stack(c) == std::vector<uint32_t>{lhs[1], lhs[2]});
+    }
+
+    SECTION("stacks round trip leaf first") {
+        REQUIRE(pcs(symbolizer, a) == first);
+        REQUIRE(pcs(symbolizer, b) == second);
+        REQUIRE(pcs(symbolizer, c) == prefix);
+    }
+
+    SECTION("symbolization") {
+        uint64_t unknown = TEXT_START + FUNCTION_COUNT * FUNCTION_SIZE;
+        uint32_t d = symbolizer.add(std::vector<uint64_t>{unknown, pc(0, 1)});
+
+        symbolizer.symbolize();
+
+        for (const auto &id: symbolizer.stack(a)) {
+            const go::symbol::Frame &frame = symbolizer.frame(id);
+            size_t index = (frame.pc - TEXT_START) / FUNCTION_SIZE;
+
+            REQUIRE(frame.entry == TEXT_START + index * FUNCTION_SIZE);
+            REQUIRE(frame.name == name(index));
+            REQUIRE(strcmp(frame.file, SOURCE_FILE) == 0);
+            REQUIRE(frame.line == line((frame.pc - frame.entry) / LINE_STEP));
+        }
+
+        const go::symbol::Frame &frame = symbolizer.frame(symbolizer.stack(d)[0]);
+
+        REQUIRE(frame.pc == unknown);
+        REQUIRE(frame.name == nullptr);
+        REQUIRE(frame.file == nullptr);
+        REQUIRE(frame.line == -1);
+
+        uint32_t e = symbolizer.add(std::vector<uint64_t>{pc(2, 0), pc(0, 1)});
+        symbolizer.symbolize();
+
+        REQUIRE(symbolizer.size() == 6);
+        REQUIRE(symbolizer.frame(symbolizer.stack(e)[0]).line == line(0));
+        REQUIRE(symbolizer.frame(symbolizer.stack(e)[0]).name == name(2));
+    }
+}
+
+TEST_CASE("stack symbolization without file capability", "[stack]") {
+    go::symbol::SymbolTable symbolTable(
+            go::symbol::VERSION120,
+            go::endian::Converter(elf::endian::Little),
+            fixture::buffer(table()),
+            0
+    );
+
+    std::optional<go::symbol::SymbolTable> compact = symbolTable.compact(
+            go::symbol::PCValueCapability,
+            [](size_t size) {
+                return go::memory::allocate(size);
+            }
+    );
+
+    REQUIRE(compact);
+    REQUIRE(!(compact->capabilities() & go::symbol::FileCapability));
+
+    go::symbol::StackSymbolizer symbolizer(&*compact);
+    uint32_t id = symbolizer.add(std::vector<uint64_t>{pc(1, 3), pc(0, 2)});
+
+    symbolizer.symbolize();
+
+    std::vector<uint32_t> frames = symbolizer.stack(id);
+
+    REQUIRE(symbolizer.frame(frames[0]).name == name(1));
+    REQUIRE(symbolizer.frame(frames[0]).line == line(3));
+    REQUIRE(symbolizer.frame(frames[0]).file == nullptr);
+    REQUIRE(symbolizer.frame(frames[1]).line == line(2));
+}
@@ -0,0 +1,52 @@
+#include <go/symbol/stats.h>
+#include <sstream>
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+TEST_CASE("prometheus histogram exposition", "[stats]") {
+    go::symbol::Stats stats;
+
+    stats.add(go::symbol::CacheHitCounter, 3);
+    stats.record(go::symbol::FindOperation, 100);
+    stats.record(go::symbol::FindOperation, 100000);
+    stats.record(go::symbol::FindOperation, UINT64_MAX / 2);
+
+    std::istringstream stream(go::symbol::prometheus(stats.snapshot(), "test"));
+
+    size_t buckets = 0;
+    uint64_t previous = 0;
+    bool infinity = false;
+    bool hits = false;
+
+    for (std::string line; std::getline(stream, line);) {
+        if (line == "test_cache_hits_total 3")
+            hits = true;
+
+        if (!line.starts_with("test_latency_seconds_bucket{operation=\"find\""))
+            continue;
+
+        uint64_t count = std::stoull(line.substr(line.rfind(' ') + 1));
+        REQUIRE(count >= previous);
+        previous = count;
+
+        buckets++;
+
+        if (line.find("le=\"+Inf\"") != std::string::npos) {
+            infinity = true;
+            REQUIRE(count == 3);
+        }
+    }
+
+    REQUIRE(hits);
+    REQUIRE(infinity);
+    REQUIRE(buckets == go::symbol::HISTOGRAM_BUCKETS);
+
+    std::string text = go::symbol::prometheus(stats.snapshot(), "test");
+
+    REQUIRE(text.find("test_latency_seconds_bucket{operation=\"read\",le=\"1e-09\"} 0\n") != std::string::npos);
+    REQUIRE(text.find("test_latency_seconds_bucket{operation=\"read\",le=\"+Inf\"} 0\n") != std::string::npos);
+}
@@ -0,0 +1,117 @@
+#include "fixture.h"
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+constexpr auto TEXT_START = 0x400000;
+constexpr auto FUNCTION_SIZE = 0x20;
+constexpr auto TOP_FRAME_FLAG = 0x1;
+constexpr auto ASM_FLAG = 0x4;
+
+namespace {
+    struct Expectation {
+        std::string name;
+        int file;
+        uint8_t flag;
+        int go118;
+        int go120;
+    };
+
+    const std::vector<Expectation> &expectations() {
+        static const std::vector<Expectation> expectations = {
+                {"main.main", 0, 0, 0, 0},
+                {"main.asm", 1, 0, go::symbol::AsmAttribute, 0},
+                {"main.flagged", 0, ASM_FLAG, go::symbol::AsmAttribute, go::symbol::AsmAttribute},
+                {
+                        "runtime.mstart",
+                        1,
+                        0,
+                        go::symbol::StackTopAttribute | go::symbol::RuntimeAttribute | go::symbol::AsmAttribute,
+                        go::symbol::StackTopAttribute | go::symbol::RuntimeAttribute
+                },
+                {"main.top", 0, TOP_FRAME_FLAG, go::symbol::StackTopAttribute, go::symbol::StackTopAttribute},
+                {"main.(*T).Method-fm", 0, 0, go::symbol::WrapperAttribute, go::symbol::WrapperAttribute},
+                {"main.T.Method", 2, 0, go::symbol::WrapperAttribute, go::symbol::WrapperAttribute}
+        };
+
+        return expectations;
+    }
+
+    std::vector<std::byte> table(go::symbol::SymbolVersion version) {
+        fixture::Table table = {version, TEXT_START, {"main.go", "asm_amd64.s", "<autogenerated>"}, {}};
+
+        for (size_t i = 0; i < expectations().size(); i++) {
+            const Expectation &expectation = expectations()[i];
+
+            table.functions.push_back({
+                    expectation.name,
+                    uint32_t(i * FUNCTION_SIZE),
+                    {{FUNCTION_SIZE, expectation.file, int(i + 1), 0}},
+                    expectation.flag
+            });
+        }
+
+        return fixture::pclntab(table);
+    }
+}
+
+TEST_CASE("function attributes", "[symbol]") {
+    auto version = GENERATE(go::symbol::VERSION118, go::symbol::VERSION120);
+
+    go::symbol::SymbolTable symbolTable(
+            version,
+            go::endian::Converter(elf::endian::Little),
+            fixture::buffer(table(version)),
+            0
+    );
+
+    auto expected = [=](size_t index) {
+        const Expectation &expectation = expectations()[index];
+        return version == go::symbol::VERSION118 ? expectation.go118 : expectation.go120;
+    };
+
+    SECTION("classification") {
+        std::span<const uint8_t> attributes = symbolTable.attributes();
+        REQUIRE(attributes.size() == expectations().size());
+
+        for (size_t i = 0; i < expectations().size(); i++) {
+            go::symbol::Symbol symbol = symbolTable[i].symbol();
+
+            INFO(symbol.name());
+            REQUIRE(attributes[i] == expected(i));
+            REQUIRE(symbol.attributes() == expected(i));
+            REQUIRE(symbol.isStackTop() == bool(expected(i) & go::symbol::StackTopAttribute));
+        }
+    }
+
+    SECTION("lookups by pc share the table attributes") {
+        for (size_t i = 0; i < expectations().size(); i++) {
+            auto it = symbolTable.find(TEXT_START + i * FUNCTION_SIZE + FUNCTION_SIZE / 2);
+
+            REQUIRE(it - symbolTable.begin() == i);
+            REQUIRE((*it).symbol().attributes() == expected(i));
+        }
+    }
+
+    SECTION("compacted tables keep attributes without files") {
+        std::optional<go::symbol::SymbolTable> compact = symbolTable.compact(
+                go::symbol::NameCapability,
+                [](size_t size) {
+                    return go::memory::allocate(size);
+                }
+        );
+
+        REQUIRE(compact);
+
+        for (size_t i = 0; i < expectations().size(); i++) {
+            go::symbol::Symbol symbol = (*compact)[i].symbol();
+
+            REQUIRE(symbol.attributes() == expected(i));
+            REQUIRE(symbol.isStackTop() == bool(expected(i) & go::symbol::StackTopAttribute));
+        }
+    }
+}
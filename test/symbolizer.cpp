@@ -0,0 +1,66 @@
+#include "fixture.h"
+#include <go/symbol/symbolizer.h>
+#include <cstring>
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+constexpr auto TEXT_START = 0x400000;
+constexpr auto FUNCTION_SIZE = 0x40;
+constexpr auto LINE_STEP = 0x10;
+constexpr auto START_LINE = 7;
+constexpr auto SOURCE_FILE = "main.go";
+
+namespace {
+    go::symbol::SymbolTable table() {
+        fixture::Table table = {go::symbol::VERSION120, TEXT_START, {SOURCE_FILE}, {}};
+
+        for (size_t i = 0; i < 2; i++) {
+            fixture::Function function = {"main.function" + std::to_string(i), uint32_t(i * FUNCTION_SIZE), {}, 0};
+
+            for (size_t step = 0; step < FUNCTION_SIZE / LINE_STEP; step++)
+                function.steps.push_back({LINE_STEP, 0, START_LINE + int(step), 0});
+
+            table.functions.push_back(std::move(function));
+        }
+
+        return {
+                go::symbol::VERSION120,
+                go::endian::Converter(elf::endian::Little),
+                fixture::buffer(fixture::pclntab(table)),
+                0
+        };
+    }
+}
+
+TEST_CASE("symbolizer capabilities", "[symbolizer]") {
+    auto capabilities = GENERATE(go::symbol::NameCapability, go::symbol::PCValueCapability, go::symbol::FileCapability);
+
+    std::optional<go::symbol::SymbolTable> compact = table().compact(capabilities, [](size_t size) {
+        return go::memory::allocate(size);
+    });
+
+    REQUIRE(compact);
+
+    go::symbol::Symbolizer symbolizer(std::move(*compact), std::nullopt);
+    int available = symbolizer.symbols().capabilities();
+
+    std::optional<go::symbol::Frame> frame = symbolizer.symbolize(TEXT_START + FUNCTION_SIZE + 2 * LINE_STEP + 1);
+
+    REQUIRE(frame);
+    REQUIRE(frame->entry == TEXT_START + FUNCTION_SIZE);
+    REQUIRE(strcmp(frame->name, "main.function1") == 0);
+    REQUIRE(frame->line == (available & go::symbol::PCValueCapability ? START_LINE + 2 : -1));
+
+    if (available & go::symbol::FileCapability)
+        REQUIRE(strcmp(frame->file, SOURCE_FILE) == 0);
+    else
+        REQUIRE(frame->file == nullptr);
+
+    REQUIRE(!symbolizer.symbolize(TEXT_START - 1));
+    REQUIRE(!symbolizer.symbolize(TEXT_START + 2 * FUNCTION_SIZE));
+}
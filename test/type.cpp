@@ -0,0 +1,278 @@
+#include "fixture.h"
+#include <go/symbol/type.h>
+#include <elf.h>
+#include <set>
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+constexpr auto TYPES_ADDRESS = 0x400000;
+constexpr auto RTYPE_SIZE = 48;
+constexpr auto TFLAG_EXTRA_STAR = 0x2;
+constexpr auto NAME_FLAG_EMBEDDED = 0x8;
+
+constexpr auto INT_TYPE = 0x000;
+constexpr auto POINT_TYPE = 0x040;
+constexpr auto POINTER_TYPE = 0x0a0;
+constexpr auto ARRAY_TYPE = 0x0e0;
+constexpr auto MAP_TYPE = 0x140;
+constexpr auto OUTER_TYPE = 0x180;
+constexpr auto HIDDEN_TYPE = 0x1e0;
+constexpr auto HIDDEN_POINTER_TYPE = 0x220;
+constexpr auto EXTRA_TYPES = 0x1000;
+constexpr auto EXTRA_TYPE_COUNT = 300;
+constexpr auto EXTRA_TYPE_SIZE = 0x40;
+
+namespace {
+    struct Field {
+        std::string_view name;
+        uint32_t type;
+        uint64_t offset;
+        bool embedded;
+    };
+
+    class Types {
+    public:
+        explicit Types(go::Version version) : mVersion(version), mData(EXTRA_TYPES + EXTRA_TYPE_COUNT * EXTRA_TYPE_SIZE) {
+
+        }
+
+    public:
+        uint32_t name(std::string_view name, bool embedded = false) {
+            auto offset = uint32_t(mData.size());
+
+            mData.push_back(std::byte(embedded && mVersion >= go::Version{1, 19} ? NAME_FLAG_EMBEDDED : 0));
+            fixture::uVarInt(mData, name.size());
+            fixture::append(mData, name);
+
+            return offset;
+        }
+
+        void rtype(uint32_t offset, uint64_t size, go::symbol::TypeKind kind, std::string_view name, int tflag = 0) {
+            uint32_t nameOffset = this->name(name);
+
+            fixture::put(mData, offset, size, 8);
+            fixture::put(mData, offset + 8, 0, 8);
+            fixture::put(mData, offset + 20, tflag, 1);
+            fixture::put(mData, offset + 23, kind, 1);
+            fixture::put(mData, offset + 40, nameOffset, 4);
+        }
+
+        void reference(uint32_t offset, size_t index, uint32_t type) {
+            fixture::put(mData, offset + RTYPE_SIZE + index * 8, TYPES_ADDRESS + type, 8);
+        }
+
+        void structure(uint32_t offset, uint64_t size, std::string_view name, const std::vector<Field> &fields) {
+            rtype(offset, size, go::symbol::StructKind, name, TFLAG_EXTRA_STAR);
+
+            std::vector<uint64_t> names;
+
+            for (const auto &field: fields)
+                names.push_back(TYPES_ADDRESS + this->name(field.name, field.embedded));
+
+            mData.resize((mData.size() + 7) & ~size_t(7));
+            uint64_t array = TYPES_ADDRESS + mData.size();
+
+            for (size_t i = 0; i < fields.size(); i++) {
+                uint64_t fieldOffset = fields[i].offset;
+
+                if (mVersion < go::Version{1, 19})
+                    fieldOffset = fieldOffset << 1 | (fields[i].embedded ? 1 : 0);
+
+                fixture::append(mData, names[i], 8);
+                fixture::append(mData, TYPES_ADDRESS + fields[i].type, 8);
+                fixture::append(mData, fieldOffset, 8);
+            }
+
+            fixture::put(mData, offset + RTYPE_SIZE + 8, array, 8);
+            fixture::put(mData, offset + RTYPE_SIZE + 16, fields.size(), 8);
+            fixture::put(mData, offset + RTYPE_SIZE + 24, fields.size(), 8);
+        }
+
+        void word(uint32_t offset, uint64_t value) {
+            fixture::put(mData, offset, value, 8);
+        }
+
+        void link(uint32_t offset) {
+            fixture::append(mLinks, offset, 4);
+        }
+
+    public:
+        [[nodiscard]] const std::vector<std::byte> &data() const {
+            return mData;
+        }
+
+        [[nodiscard]] const std::vector<std::byte> &links() const {
+            return mLinks;
+        }
+
+    private:
+        go::Version mVersion;
+        std::vector<std::byte> mData;
+        std::vector<std::byte> mLinks;
+    };
+
+    Types build(go::Version version) {
+        Types types(version);
+
+        types.rtype(INT_TYPE, 8, go::symbol::IntKind, "int");
+        types.structure(POINT_TYPE, 16, "*main.Point", {{"X", INT_TYPE, 0, false}, {"Y", INT_TYPE, 8, false}});
+
+        types.rtype(POINTER_TYPE, 8, go::symbol::PointerKind, "*main.Point");
+        types.reference(POINTER_TYPE, 0, POINT_TYPE);
+
+        types.rtype(ARRAY_TYPE, 32, go::symbol::ArrayKind, "[4]int");
+        types.reference(ARRAY_TYPE, 0, INT_TYPE);
+        types.word(ARRAY_TYPE + RTYPE_SIZE + 16, 4);
+
+        types.rtype(MAP_TYPE, 8, go::symbol::MapKind, "map[int]*main.Point");
+        types.reference(MAP_TYPE, 0, INT_TYPE);
+        types.reference(MAP_TYPE, 1, POINTER_TYPE);
+
+        types.structure(
+                OUTER_TYPE,
+                24,
+                "*main.Outer",
+                {{"Point", POINT_TYPE, 0, true}, {"Count", INT_TYPE, 16, false}}
+        );
+
+        types.rtype(HIDDEN_TYPE, 8, go::symbol::IntKind, "*main.hidden", TFLAG_EXTRA_STAR);
+
+        types.rtype(HIDDEN_POINTER_TYPE, 8, go::symbol::PointerKind, "*main.hidden");
+        types.reference(HIDDEN_POINTER_TYPE, 0, HIDDEN_TYPE);
+
+        for (uint32_t offset: {INT_TYPE, POINT_TYPE, POINTER_TYPE, ARRAY_TYPE, MAP_TYPE, OUTER_TYPE, HIDDEN_POINTER_TYPE})
+            types.link(offset);
+
+        for (int i = 0; i < EXTRA_TYPE_COUNT; i++) {
+            uint32_t offset = EXTRA_TYPES + i * EXTRA_TYPE_SIZE;
+
+            types.rtype(offset, 8, go::symbol::IntKind, "*main.T" + std::to_string(i), TFLAG_EXTRA_STAR);
+            types.link(offset);
+        }
+
+        return types;
+    }
+}
+
+TEST_CASE("runtime type table", "[type]") {
+    auto version = GENERATE(go::Version{1, 18}, go::Version{1, 20});
+    Types types = build(version);
+
+    fixture::TemporaryFile file(fixture::elf({ET_EXEC, {{TYPES_ADDRESS, types.data()}}, {}}));
+    std::optional<elf::Reader> reader = elf::openFile(file.path());
+    REQUIRE(reader);
+
+    go::symbol::TypeTable table(
+            *reader,
+            std::span<const std::byte>{types.links()},
+            version,
+            TYPES_ADDRESS,
+            TYPES_ADDRESS + types.data().size(),
+            0,
+            8,
+            go::endian::Converter(elf::endian::Little)
+    );
+
+    SECTION("enumeration covers typelinks only") {
+        REQUIRE(table.size() == 7 + EXTRA_TYPE_COUNT);
+
+        std::set<std::string_view> names;
+
+        for (size_t i = 0; i < table.size(); i++) {
+            const go::symbol::Type *type = table[i];
+            REQUIRE(type);
+            names.insert(type->name);
+        }
+
+        REQUIRE(names.contains("int"));
+        REQUIRE(names.contains("main.Point"));
+        REQUIRE(names.contains("*main.Point"));
+        REQUIRE(names.contains("[4]int"));
+        REQUIRE(names.contains("map[int]*main.Point"));
+        REQUIRE(names.contains("main.Outer"));
+        REQUIRE(names.contains("*main.hidden"));
+        REQUIRE(names.contains("main.T299"));
+        REQUIRE(!names.contains("main.hidden"));
+        REQUIRE(table[table.size()] == nullptr);
+    }
+
+    SECTION("types outside typelinks are reachable by address") {
+        const go::symbol::Type *hidden = table.find(TYPES_ADDRESS + HIDDEN_TYPE);
+
+        REQUIRE(hidden);
+        REQUIRE(hidden->name == "main.hidden");
+        REQUIRE(table.address(hidden) == TYPES_ADDRESS + HIDDEN_TYPE);
+        REQUIRE(table.elem(table.find(TYPES_ADDRESS + HIDDEN_POINTER_TYPE)) == hidden);
+
+        REQUIRE(table.find(TYPES_ADDRESS - 1) == nullptr);
+        REQUIRE(table.find(TYPES_ADDRESS + types.data().size()) == nullptr);
+    }
+
+    SECTION("lookups are cached across table growth") {
+        std::vector<const go::symbol::Type *> first;
+
+        for (size_t i = 0; i < table.size(); i++)
+            first.push_back(table[i]);
+
+        for (size_t i = 0; i < table.size(); i++) {
+            REQUIRE(table[i] == first[i]);
+            REQUIRE(table.lookup(first[i]->offset) == first[i]);
+        }
+    }
+
+    SECTION("composite types") {
+        const go::symbol::Type *integer = table.find(TYPES_ADDRESS + INT_TYPE);
+        const go::symbol::Type *point = table.find(TYPES_ADDRESS + POINT_TYPE);
+        const go::symbol::Type *pointer = table.find(TYPES_ADDRESS + POINTER_TYPE);
+        const go::symbol::Type *array = table.find(TYPES_ADDRESS + ARRAY_TYPE);
+        const go::symbol::Type *map = table.find(TYPES_ADDRESS + MAP_TYPE);
+
+        REQUIRE(integer->kind == go::symbol::IntKind);
+        REQUIRE(integer->size == 8);
+        REQUIRE(point->kind == go::symbol::StructKind);
+        REQUIRE(point->size == 16);
+
+        REQUIRE(table.elem(pointer) == point);
+        REQUIRE(table.elem(array) == integer);
+        REQUIRE(table.length(array) == 4);
+        REQUIRE(table.key(map) == integer);
+        REQUIRE(table.elem(map) == pointer);
+
+        REQUIRE(table.key(pointer) == nullptr);
+        REQUIRE(table.elem(integer) == nullptr);
+        REQUIRE(!table.length(map));
+    }
+
+    SECTION("struct fields") {
+        const go::symbol::Type *point = table.find(TYPES_ADDRESS + POINT_TYPE);
+        std::span<const go::symbol::TypeField> fields = table.fields(point);
+
+        REQUIRE(fields.size() == 2);
+        REQUIRE(fields[0].name == "X");
+        REQUIRE(fields[0].type == INT_TYPE);
+        REQUIRE(fields[0].offset == 0);
+        REQUIRE(!fields[0].embedded);
+        REQUIRE(fields[1].name == "Y");
+        REQUIRE(fields[1].offset == 8);
+
+        REQUIRE(table.fields(point).data() == fields.data());
+
+        fields = table.fields(table.find(TYPES_ADDRESS + OUTER_TYPE));
+
+        REQUIRE(fields.size() == 2);
+        REQUIRE(fields[0].name == "Point");
+        REQUIRE(fields[0].type == POINT_TYPE);
+        REQUIRE(fields[0].offset == 0);
+        REQUIRE(fields[0].embedded);
+        REQUIRE(fields[1].name == "Count");
+        REQUIRE(fields[1].offset == 16);
+        REQUIRE(!fields[1].embedded);
+
+        REQUIRE(table.fields(table.find(TYPES_ADDRESS + INT_TYPE)).empty());
+    }
+}